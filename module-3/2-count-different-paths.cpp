@@ -17,7 +17,7 @@
 #include <limits>
 #include <sstream>
 #include <vector>
-#include <queue>
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 
@@ -26,6 +26,61 @@
 
 using vertex_t = std::uint64_t;
 
+// bfs levels, path counts and the bfs queue of `PathsCount`, kept between queries. stamped
+// with the query that wrote them, so a new query does not refill them.
+class QueryContext {
+ public:
+    explicit QueryContext(std::size_t size)
+        : min_path_distance_(size), min_path_count_(size), stamps_(size, 0) {
+    }
+
+    [[nodiscard]] std::size_t VerticesCount() const {
+        return stamps_.size();
+    }
+
+    void Begin() {
+        queue_.clear();
+        if (++epoch_ == 0) {
+            // the stamp wrapped around and could match a stale entry.
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    // `max()` for vertices not reached by the current query.
+    [[nodiscard]] std::size_t GetDistance(vertex_t vertex) const {
+        return stamps_[vertex] == epoch_ ? min_path_distance_[vertex] : std::numeric_limits<std::size_t>::max();
+    }
+
+    [[nodiscard]] std::size_t GetCount(vertex_t vertex) const {
+        return stamps_[vertex] == epoch_ ? min_path_count_[vertex] : 0;
+    }
+
+    void Reach(vertex_t vertex, std::size_t distance, std::size_t count) {
+        stamps_[vertex] = epoch_;
+        min_path_distance_[vertex] = distance;
+        min_path_count_[vertex] = count;
+    }
+
+    void AddCount(vertex_t vertex, std::size_t count) {
+        assert(stamps_[vertex] == epoch_);
+        min_path_count_[vertex] += count;
+    }
+
+    // every vertex is pushed once, so a vector with a moving head is enough for a queue.
+    [[nodiscard]] std::vector<vertex_t>& GetQueue() {
+        return queue_;
+    }
+
+ private:
+    std::vector<std::size_t> min_path_distance_;
+    std::vector<std::size_t> min_path_count_;
+    std::vector<std::uint32_t> stamps_;
+    std::uint32_t epoch_ = 0;
+    std::vector<vertex_t> queue_;
+};
+
+
 struct IGraph {
     virtual ~IGraph() {}
 
@@ -34,34 +89,40 @@ struct IGraph {
 
     [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
 
-    [[nodiscard]] virtual std::vector<vertex_t> GetNextVertices(vertex_t vertex) const = 0;
+    [[nodiscard]] virtual const std::vector<vertex_t>& GetNextVertices(vertex_t vertex) const = 0;
     [[nodiscard]] virtual std::vector<vertex_t> GetPrevVertices(vertex_t vertex) const = 0;
 
-    std::size_t PathsCount(vertex_t from, vertex_t to) const {
-        std::vector<std::size_t> min_path_distance(VerticesCount(), std::numeric_limits<std::size_t>::max());
-        std::vector<std::size_t> min_path_count(VerticesCount(), 0);
+    // bfs counting shortest paths, the state lives in `context`, so repeated queries
+    // allocate nothing and cost only the vertices they reach.
+    std::size_t PathsCount(vertex_t from, vertex_t to, QueryContext& context) const {
+        assert(context.VerticesCount() >= VerticesCount());
 
-        min_path_distance[from] = 0;
-        min_path_count[from] = 1;
+        context.Begin();
+        context.Reach(from, 0, 1);
 
-        std::queue<vertex_t> queue;
-        queue.push(from);
-        while (!queue.empty()) {
-            auto vertex = queue.front();
-            queue.pop();
+        auto& queue = context.GetQueue();
+        queue.push_back(from);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            auto vertex = queue[head];
+            auto distance = context.GetDistance(vertex);
 
             for (const auto& next_vertex: GetNextVertices(vertex)) {
-                if (min_path_distance[vertex] + 1 < min_path_distance[next_vertex]) {
-                    min_path_distance[next_vertex] = min_path_distance[vertex] + 1;
-                    min_path_count[next_vertex] = min_path_count[vertex];
-                    queue.push(next_vertex);
-                } else if (min_path_distance[vertex] + 1 == min_path_distance[next_vertex]) {
-                    min_path_count[next_vertex] += min_path_count[vertex];
+                if (distance + 1 < context.GetDistance(next_vertex)) {
+                    context.Reach(next_vertex, distance + 1, context.GetCount(vertex));
+                    queue.push_back(next_vertex);
+                } else if (distance + 1 == context.GetDistance(next_vertex)) {
+                    context.AddCount(next_vertex, context.GetCount(vertex));
                 }
             }
         }
 
-        return min_path_count[to];
+        return context.GetCount(to);
+    }
+
+    // the same with a context allocated for one query.
+    std::size_t PathsCount(vertex_t from, vertex_t to) const {
+        QueryContext context(VerticesCount());
+        return PathsCount(from, to, context);
     }
 };
 
@@ -87,7 +148,7 @@ class ListGraph: public IGraph {
         return adjacency_lists_.size();
     }
 
-    [[nodiscard]] std::vector<vertex_t> GetNextVertices(vertex_t vertex) const override {
+    [[nodiscard]] const std::vector<vertex_t>& GetNextVertices(vertex_t vertex) const override {
         assert(vertex < VerticesCount());
         return adjacency_lists_[vertex];
     }
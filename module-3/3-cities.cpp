@@ -26,17 +26,21 @@
 #include <cassert>
 #include <cstdint>
 #include <utility>
-#include <set>
+#include <algorithm>
+#include <array>
 
 // #define DEBUG
 
 
-using vertex_t = std::uint64_t;
+// N ≤ 10000 and w ≤ 10000, so 32 bits hold both, and every road, kept in the forward
+// and the reverse lists, takes 8 bytes there instead of 16.
+using vertex_t = std::uint32_t;
+using weight_t = std::uint32_t;
 
 
 struct Edge {
     vertex_t to;
-    std::size_t weight;
+    weight_t weight;
 };
 
 bool operator < (const Edge& lhs, const Edge& rhs) {
@@ -44,90 +48,236 @@ bool operator < (const Edge& lhs, const Edge& rhs) {
 }
 
 
-struct IGraph {
-    virtual ~IGraph() {}
+// 4-ary heap of vertices keeping their positions, so a distance is decreased in place
+// instead of inserting one more entry.
+class IndexedHeap {
+ public:
+    explicit IndexedHeap(std::size_t size): positions_(size, ABSENT) {
+    }
 
-    virtual void AddEdge(vertex_t from, vertex_t to, std::size_t weight) = 0;
+    [[nodiscard]] bool Empty() const {
+        return nodes_.empty();
+    }
 
-    [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
+    // inserting `vertex` or decreasing its key.
+    void Push(vertex_t vertex, std::size_t key) {
+        auto position = positions_[vertex];
+        if (position == ABSENT) {
+            position = nodes_.size();
+            nodes_.emplace_back(key, vertex);
+        }
+        nodes_[position].first = key;
 
-    [[nodiscard]] virtual std::vector<Edge> GetNextEdges(vertex_t vertex) const = 0;
-    [[nodiscard]] virtual std::vector<Edge> GetPrevEdges(vertex_t vertex) const = 0;
+        auto node = nodes_[position];
+        while (position > 0 && nodes_[(position - 1) / ARITY].first > node.first) {
+            Place(position, nodes_[(position - 1) / ARITY]);
+            position = (position - 1) / ARITY;
+        }
+        Place(position, node);
+    }
 
-    std::size_t GetDistance(vertex_t from, vertex_t to) {
-        std::vector<std::size_t> distances(VerticesCount(), std::numeric_limits<std::size_t>::max());
-        std::set<std::pair<std::size_t, vertex_t>> queue;
+    // the vertex with the minimum key as `{key, vertex}`.
+    std::pair<std::size_t, vertex_t> Pop() {
+        auto top = nodes_.front();
+        positions_[top.second] = ABSENT;
 
-        distances[from] = 0;
-        queue.insert({0, from});
+        auto node = nodes_.back();
+        nodes_.pop_back();
+        if (nodes_.empty()) {
+            return top;
+        }
 
-        while (!queue.empty()) {
-            auto prev_edge = *queue.begin();
-            queue.erase(queue.begin());
+        std::size_t position = 0;
+        while (position * ARITY + 1 < nodes_.size()) {
+            auto min_child = position * ARITY + 1;
+            for (auto child = min_child + 1; child < std::min(position * ARITY + 1 + ARITY, nodes_.size()); ++child) {
+                if (nodes_[child].first < nodes_[min_child].first) {
+                    min_child = child;
+                }
+            }
+            if (node.first <= nodes_[min_child].first) {
+                break;
+            }
+            Place(position, nodes_[min_child]);
+            position = min_child;
+        }
+        Place(position, node);
 
-            auto curr_vertex = prev_edge.second;
-            for (const auto& next_edge: GetNextEdges(curr_vertex)) {
-                if (distances[curr_vertex] + next_edge.weight < distances[next_edge.to]) {
-                    if (distances[curr_vertex] != std::numeric_limits<std::size_t>::max()) {
-                        queue.erase({distances[curr_vertex], curr_vertex});
-                    }
+        return top;
+    }
 
-                    distances[next_edge.to] = distances[curr_vertex] + next_edge.weight;
-                    queue.insert({next_edge.weight, next_edge.to});
+    // dropping all vertices in the time of their number.
+    void Clear() {
+        for (const auto& node: nodes_) {
+            positions_[node.second] = ABSENT;
+        }
+        nodes_.clear();
+    }
+
+ private:
+    static constexpr std::size_t ARITY = 4;
+    static constexpr std::size_t ABSENT = std::numeric_limits<std::size_t>::max();
+
+    void Place(std::size_t position, const std::pair<std::size_t, vertex_t>& node) {
+        nodes_[position] = node;
+        positions_[node.second] = position;
+    }
+
+    std::vector<std::pair<std::size_t, vertex_t>> nodes_;
+    std::vector<std::size_t> positions_;
+};
+
+
+// distances from both ends and the two heaps of `GetDistance`, kept between queries. a side's
+// distance counts only if it was set by the current query.
+class QueryContext {
+ public:
+    explicit QueryContext(std::size_t size)
+        : distances_{std::vector<std::size_t>(size), std::vector<std::size_t>(size)},
+          stamps_{std::vector<std::uint32_t>(size, 0), std::vector<std::uint32_t>(size, 0)},
+          queues_{IndexedHeap(size), IndexedHeap(size)} {
+    }
+
+    [[nodiscard]] std::size_t VerticesCount() const {
+        return distances_[0].size();
+    }
+
+    void Begin() {
+        for (auto& queue: queues_) {
+            queue.Clear();
+        }
+        if (++epoch_ == 0) {
+            // the stamp wrapped around and could match a stale distance.
+            for (auto& stamps: stamps_) {
+                std::fill(stamps.begin(), stamps.end(), 0);
+            }
+            epoch_ = 1;
+        }
+    }
+
+    // `max()` for vertices not reached by the side of the current query.
+    [[nodiscard]] std::size_t GetDistance(std::size_t side, vertex_t vertex) const {
+        return stamps_[side][vertex] == epoch_ ? distances_[side][vertex] : std::numeric_limits<std::size_t>::max();
+    }
+
+    void SetDistance(std::size_t side, vertex_t vertex, std::size_t distance) {
+        stamps_[side][vertex] = epoch_;
+        distances_[side][vertex] = distance;
+    }
+
+    [[nodiscard]] IndexedHeap& GetQueue(std::size_t side) {
+        return queues_[side];
+    }
+
+ private:
+    std::array<std::vector<std::size_t>, 2> distances_;
+    std::array<std::vector<std::uint32_t>, 2> stamps_;
+    std::array<IndexedHeap, 2> queues_;
+    std::uint32_t epoch_ = 0;
+};
+
+
+struct IGraph {
+    virtual ~IGraph() {}
+
+    virtual void AddEdge(vertex_t from, vertex_t to, weight_t weight) = 0;
+
+    [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
+
+    [[nodiscard]] virtual const std::vector<Edge>& GetNextEdges(vertex_t vertex) const = 0;
+    // `to` of a prev edge is the vertex it comes from.
+    [[nodiscard]] virtual const std::vector<Edge>& GetPrevEdges(vertex_t vertex) const = 0;
+
+    // bidirectional dijkstra: the forward search from `from` goes along next edges and the
+    // backward one from `to` along prev edges, the side with the smaller radius moves. the
+    // shortest path found through an edge joining the searches is final once the radii sum
+    // up to it, so neither search has to reach the whole graph. the state of both searches
+    // lives in `context`, so repeated queries allocate nothing.
+    std::size_t GetDistance(vertex_t from, vertex_t to, QueryContext& context) const {
+        const auto INF = std::numeric_limits<std::size_t>::max();
+        assert(context.VerticesCount() >= VerticesCount());
+
+        context.Begin();
+        std::array<std::size_t, 2> radii{0, 0};
+
+        context.SetDistance(0, from, 0);
+        context.GetQueue(0).Push(from, 0);
+        context.SetDistance(1, to, 0);
+        context.GetQueue(1).Push(to, 0);
+
+        auto best = from == to ? 0 : INF;
+        while (!context.GetQueue(0).Empty() && !context.GetQueue(1).Empty()) {
+            auto side = radii[0] <= radii[1] ? 0 : 1;
+            auto [distance, curr_vertex] = context.GetQueue(side).Pop();
+
+            radii[side] = distance;
+            if (distance + radii[1 - side] >= best) {
+                break;
+            }
+
+            const auto& edges = side == 0 ? GetNextEdges(curr_vertex) : GetPrevEdges(curr_vertex);
+            for (const auto& edge: edges) {
+                if (distance + edge.weight < context.GetDistance(side, edge.to)) {
+                    context.SetDistance(side, edge.to, distance + edge.weight);
+                    context.GetQueue(side).Push(edge.to, distance + edge.weight);
+                }
+                if (context.GetDistance(1 - side, edge.to) != INF) {
+                    best = std::min(best, distance + edge.weight + context.GetDistance(1 - side, edge.to));
                 }
             }
         }
 
-        assert(distances[to] != std::numeric_limits<std::size_t>::max());
-        return distances[to];
+        assert(best != INF);
+        return best;
+    }
+
+    // the same with a context allocated for one query.
+    std::size_t GetDistance(vertex_t from, vertex_t to) const {
+        QueryContext context(VerticesCount());
+        return GetDistance(from, to, context);
     }
 };
 
 
 class ListGraph: public IGraph {
  public:
-    explicit ListGraph(std::size_t size): adjacency_lists_(size) {
+    explicit ListGraph(std::size_t size): adjacency_lists_(size), reverse_lists_(size) {
     }
 
-    explicit ListGraph(const IGraph& graph): adjacency_lists_(graph.VerticesCount()) {
-        for (vertex_t from = 0; from < graph.VerticesCount(); ++from) {
-            adjacency_lists_[from] = graph.GetNextEdges(from);
+    explicit ListGraph(const IGraph& graph)
+        : adjacency_lists_(graph.VerticesCount()), reverse_lists_(graph.VerticesCount()) {
+        for (vertex_t vertex = 0; vertex < graph.VerticesCount(); ++vertex) {
+            adjacency_lists_[vertex] = graph.GetNextEdges(vertex);
+            reverse_lists_[vertex] = graph.GetPrevEdges(vertex);
         }
     }
 
-    void AddEdge(vertex_t from, vertex_t to, std::size_t weight) override {
+    void AddEdge(vertex_t from, vertex_t to, weight_t weight) override {
         assert(from < VerticesCount());
         assert(to < VerticesCount());
 
         adjacency_lists_[from].push_back(Edge{to, weight});
+        reverse_lists_[to].push_back(Edge{from, weight});
     }
 
     [[nodiscard]] std::size_t VerticesCount() const override {
         return adjacency_lists_.size();
     }
 
-    [[nodiscard]] std::vector<Edge> GetNextEdges(vertex_t vertex) const override {
+    [[nodiscard]] const std::vector<Edge>& GetNextEdges(vertex_t vertex) const override {
         assert(vertex < VerticesCount());
         return adjacency_lists_[vertex];
     }
 
-    [[nodiscard]] std::vector<Edge> GetPrevEdges(vertex_t vertex) const override {
+    [[nodiscard]] const std::vector<Edge>& GetPrevEdges(vertex_t vertex) const override {
         assert(vertex < VerticesCount());
-
-        std::vector<Edge> prev_vertices;
-        for (vertex_t from = 0; from < VerticesCount(); ++from) {
-            for (const auto& edge: adjacency_lists_[from]) {
-                if (edge.to == vertex) {
-                    prev_vertices.push_back(Edge{from, edge.weight});
-                }
-            }
-        }
-
-        return prev_vertices;
+        return reverse_lists_[vertex];
     }
 
  private:
     std::vector<std::vector<Edge>> adjacency_lists_;
+    // prev edges of every vertex, kept for the backward search of `GetDistance`.
+    std::vector<std::vector<Edge>> reverse_lists_;
 };
 
 
@@ -136,7 +286,7 @@ void Run(std::istream& input, std::ostream& output) {
     input >> vertex_count >> edges_count;
 
     vertex_t from, to;
-    std::size_t weight;
+    weight_t weight;
     ListGraph graph(vertex_count);
     for (std::size_t i = 0; i < edges_count; ++i) {
         input >> from >> to >> weight;
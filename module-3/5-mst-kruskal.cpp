@@ -27,12 +27,14 @@
 // #define DEBUG
 
 
-using vertex_t = std::uint64_t;
+// n ≤ 20000 and w ≤ 100000: the sorted edge list takes 12 bytes per edge instead of 24.
+using vertex_t = std::uint32_t;
+using weight_t = std::uint32_t;
 
 struct Edge {
     vertex_t from;
     vertex_t to;
-    std::size_t weight;
+    weight_t weight;
 };
 
 bool operator < (const Edge& lhs, const Edge& rhs) {
@@ -42,7 +44,7 @@ bool operator < (const Edge& lhs, const Edge& rhs) {
 struct IGraph {
     virtual ~IGraph() {}
 
-    virtual void AddEdge(vertex_t from, vertex_t to, std::size_t weight) = 0;
+    virtual void AddEdge(vertex_t from, vertex_t to, weight_t weight) = 0;
 
     [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
 
@@ -65,7 +67,7 @@ class ArcGraph: public IGraph {
         }
     }
 
-    void AddEdge(vertex_t from, vertex_t to, std::size_t weight) override {
+    void AddEdge(vertex_t from, vertex_t to, weight_t weight) override {
         assert(from < VerticesCount());
         assert(to < VerticesCount());
         edges_.push_back({from, to, weight});
@@ -201,7 +203,7 @@ void Run(std::istream& input, std::ostream& output) {
     input >> vertex_count >> edges_count;
 
     vertex_t from, to;
-    std::size_t weight;
+    weight_t weight;
     ArcGraph graph(vertex_count);
     for (std::size_t i = 0; i < edges_count; ++i) {
         input >> from >> to >> weight;
@@ -27,12 +27,13 @@
 // #define DEBUG
 
 
-using vertex_t = std::uint64_t;
+using vertex_t = std::uint32_t;
+using weight_t = std::uint32_t;
 
 
 struct Edge {
     vertex_t to;
-    std::size_t weight;
+    weight_t weight;
 };
 
 bool operator < (const Edge& lhs, const Edge& rhs) {
@@ -43,11 +44,11 @@ bool operator < (const Edge& lhs, const Edge& rhs) {
 struct IGraph {
     virtual ~IGraph() {}
 
-    virtual void AddEdge(vertex_t from, vertex_t to, std::size_t weight) = 0;
+    virtual void AddEdge(vertex_t from, vertex_t to, weight_t weight) = 0;
 
     [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
 
-    [[nodiscard]] virtual std::vector<Edge> GetNextEdges(vertex_t vertex) const = 0;
+    [[nodiscard]] virtual const std::vector<Edge>& GetNextEdges(vertex_t vertex) const = 0;
     [[nodiscard]] virtual std::vector<Edge> GetPrevEdges(vertex_t vertex) const = 0;
 
     std::size_t GetWeightMST() {
@@ -107,7 +108,7 @@ class ListGraph: public IGraph {
         }
     }
 
-    void AddEdge(vertex_t from, vertex_t to, std::size_t weight) override {
+    void AddEdge(vertex_t from, vertex_t to, weight_t weight) override {
         assert(from < VerticesCount());
         assert(to < VerticesCount());
 
@@ -118,7 +119,7 @@ class ListGraph: public IGraph {
         return adjacency_lists_.size();
     }
 
-    [[nodiscard]] std::vector<Edge> GetNextEdges(vertex_t vertex) const override {
+    [[nodiscard]] const std::vector<Edge>& GetNextEdges(vertex_t vertex) const override {
         assert(vertex < VerticesCount());
         return adjacency_lists_[vertex];
     }
@@ -148,7 +149,7 @@ void Run(std::istream& input, std::ostream& output) {
     input >> vertex_count >> edges_count;
 
     vertex_t from, to;
-    std::size_t weight;
+    weight_t weight;
     ListGraph graph(vertex_count);
     for (std::size_t i = 0; i < edges_count; ++i) {
         input >> from >> to >> weight;
@@ -0,0 +1,85 @@
+/*
+ * Центральность по посредничеству (алгоритм Брандеса) на случайном
+ * неориентированном графе: точный подсчет на 1 потоке и на всех ядрах и
+ * приближенный по случайной выборке источников со средней относительной
+ * ошибкой на 1% вершин с наибольшей центральностью.
+ *
+ * Запуск
+ * betweenness_bench [кол-во вершин] [кол-во ребер] [размер выборки]
+ * По умолчанию 2^14 вершин, 2^16 ребер и выборка из 256 источников.
+ */
+
+#include "graph/betweenness.hpp"
+#include "graph/csr_graph.hpp"
+#include "graph/parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t vertex_count = argc > 1 ? std::stoull(argv[1]) : std::size_t{1} << 14;
+    std::size_t edges_count = argc > 2 ? std::stoull(argv[2]) : std::size_t{1} << 16;
+    std::size_t samples = argc > 3 ? std::stoull(argv[3]) : 256;
+
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<std::uint64_t> random_vertex(0, vertex_count - 1);
+
+    std::vector<graph::CsrGraph::Edge> edges;
+    edges.reserve(2 * edges_count);
+    for (std::size_t i = 0; i < edges_count; ++i) {
+        auto from = random_vertex(random);
+        auto to = random_vertex(random);
+        edges.emplace_back(from, to);
+        edges.emplace_back(to, from);
+    }
+
+    graph::CsrGraph graph(vertex_count, edges);
+    edges = {};
+
+    std::vector<double> exact, parallel, approximate;
+    auto serial_time = MeasureSeconds([&] { exact = graph::BetweennessCentrality(graph, 1); });
+    auto parallel_time = MeasureSeconds([&] { parallel = graph::BetweennessCentrality(graph); });
+    auto approximate_time = MeasureSeconds([&] {
+        approximate = graph::ApproximateBetweennessCentrality(graph, samples, 7);
+    });
+
+    for (std::size_t vertex = 0; vertex < vertex_count; ++vertex) {
+        if (std::abs(parallel[vertex] - exact[vertex]) > 1e-9 * (1 + exact[vertex])) {
+            std::cerr << "parallel betweenness differs from the serial one" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::size_t> top(vertex_count);
+    std::iota(top.begin(), top.end(), 0);
+    std::sort(top.begin(), top.end(), [&](std::size_t lhs, std::size_t rhs) { return exact[lhs] > exact[rhs]; });
+    top.resize(std::max<std::size_t>(vertex_count / 100, 1));
+    double error = 0;
+    for (const auto& vertex: top) {
+        error += std::abs(approximate[vertex] - exact[vertex]) / exact[vertex] / static_cast<double>(top.size());
+    }
+
+    std::cout << "mode,threads,seconds,top_mean_relative_error" << std::endl;
+    std::cout << "exact,1," << serial_time << ",0" << std::endl;
+    std::cout << "exact," << graph::DefaultThreadsCount() << "," << parallel_time << ",0" << std::endl;
+    std::cout << "sampled_" << samples << "," << graph::DefaultThreadsCount() << "," << approximate_time << ","
+              << error << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/*
+ * Иерархия сжатий на дорожной сети: время построения на 1 потоке и на всех
+ * ядрах, число добавленных рёбер, сохранение и загрузка с диска, и время
+ * запроса расстояния по сравнению с двунаправленным алгоритмом Дейкстры.
+ * Затем таблица расстояний между [размер таблицы] источниками и столькими же
+ * стоками: корзины на иерархии, Дейкстра с ранней остановкой и S x T запросов.
+ *
+ * Запуск
+ * ch_bench [сторона сетки] [кол-во запросов] [размер таблицы]
+ * По умолчанию сетка 150 x 150, 1000 запросов между случайными вершинами и
+ * таблица 100 x 100.
+ * Сетка без иерархии дорог - худший случай для сжатия: ядро из вершин
+ * разделителя сетки становится плотным, и построение растёт быстрее линейного.
+ */
+
+#include "graph/contraction_hierarchy.hpp"
+#include "graph/distance_table.hpp"
+#include "graph/generators.hpp"
+#include "graph/parallel.hpp"
+#include "graph/traversal.hpp"
+#include "graph/weighted_csr_graph.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using RoadGraph = graph::WeightedCsrGraph<std::uint32_t, std::uint32_t>;
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// counts settled vertices.
+struct SettledCounter: graph::TraversalVisitor {
+    void DiscoverVertex(std::uint64_t) {
+        ++settled;
+    }
+
+    std::size_t settled = 0;
+};
+
+int main(int argc, char* argv[]) {
+    std::size_t side = argc > 1 ? std::stoull(argv[1]) : 150;
+    std::size_t queries = argc > 2 ? std::stoull(argv[2]) : 1000;
+    std::size_t table_size = argc > 3 ? std::stoull(argv[3]) : 100;
+
+    std::vector<RoadGraph::Edge> edges;
+    for (const auto& edge: graph::RoadEdges(side, side, 42)) {
+        edges.push_back({static_cast<std::uint32_t>(edge.from), static_cast<std::uint32_t>(edge.to),
+                         static_cast<std::uint32_t>(edge.weight)});
+    }
+    RoadGraph road(side * side, edges, graph::ReverseEdges::KEEP);
+
+    std::cout << "step,seconds" << std::endl;
+    std::optional<graph::ContractionHierarchy> hierarchy;
+    for (auto threads_count: {std::size_t{1}, graph::DefaultThreadsCount()}) {
+        auto time = MeasureSeconds([&] { hierarchy.emplace(road, threads_count); });
+        std::cout << "build_" << threads_count << "_threads," << time << std::endl;
+    }
+
+    auto path = std::filesystem::temp_directory_path() / "ch_bench.bin";
+    std::cout << "save," << MeasureSeconds([&] { hierarchy->Save(path); }) << std::endl;
+    std::cout << "load," << MeasureSeconds([&] { hierarchy.emplace(path); }) << std::endl;
+    std::filesystem::remove(path);
+
+    std::cout << std::endl << "edges,shortcuts" << std::endl;
+    std::cout << road.EdgesCount() << "," << hierarchy->ShortcutsCount() << std::endl;
+
+    std::mt19937_64 random(7);
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs(queries);
+    for (auto& [from, to]: pairs) {
+        from = random() % road.VerticesCount();
+        to = random() % road.VerticesCount();
+    }
+
+    std::vector<std::uint64_t> expected(queries), distances(queries);
+    SettledCounter dijkstra_counter, hierarchy_counter;
+    auto dijkstra_time = MeasureSeconds([&] {
+        for (std::size_t i = 0; i < queries; ++i) {
+            expected[i] = graph::BidirectionalDijkstraDistance<graph::RadixHeap>(road, pairs[i].first, pairs[i].second,
+                                                                                 dijkstra_counter);
+        }
+    });
+
+    graph::ContractionHierarchyQuery query(*hierarchy);
+    auto hierarchy_time = MeasureSeconds([&] {
+        for (std::size_t i = 0; i < queries; ++i) {
+            distances[i] = query.Distance(pairs[i].first, pairs[i].second, hierarchy_counter);
+        }
+    });
+    if (distances != expected) {
+        std::cerr << "contraction hierarchy gave a wrong distance" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    auto per_query = static_cast<double>(queries);
+    std::cout << std::endl << "mode,seconds_per_query,settled_per_query" << std::endl;
+    std::cout << "bidirectional_radix," << dijkstra_time / per_query << ","
+              << static_cast<double>(dijkstra_counter.settled) / per_query << std::endl;
+    std::cout << "ch," << hierarchy_time / per_query << ","
+              << static_cast<double>(hierarchy_counter.settled) / per_query << std::endl;
+
+    std::vector<std::uint64_t> sources(table_size), targets(table_size);
+    for (std::size_t i = 0; i < table_size; ++i) {
+        sources[i] = random() % road.VerticesCount();
+        targets[i] = random() % road.VerticesCount();
+    }
+
+    std::vector<std::uint64_t> table, expected_table(table_size * table_size);
+    std::cout << std::endl << "table,seconds" << std::endl;
+    auto queries_time = MeasureSeconds([&] {
+        for (std::size_t i = 0; i < table_size; ++i) {
+            for (std::size_t j = 0; j < table_size; ++j) {
+                expected_table[i * table_size + j] = query.Distance(sources[i], targets[j]);
+            }
+        }
+    });
+    std::cout << "ch_queries," << queries_time << std::endl;
+    for (auto threads_count: {std::size_t{1}, graph::DefaultThreadsCount()}) {
+        auto time = MeasureSeconds([&] { table = graph::DistanceTable(road, sources, targets, threads_count); });
+        if (table != expected_table) {
+            std::cerr << "dijkstra distance table is wrong" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "dijkstra_" << threads_count << "_threads," << time << std::endl;
+
+        time = MeasureSeconds([&] { table = graph::DistanceTable(*hierarchy, sources, targets, threads_count); });
+        if (table != expected_table) {
+            std::cerr << "contraction hierarchy distance table is wrong" << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "ch_buckets_" << threads_count << "_threads," << time << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
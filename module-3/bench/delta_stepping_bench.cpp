@@ -0,0 +1,96 @@
+/*
+ * Масштабирование delta-stepping по потокам (1, 2, 4, 8, 16) на случайном
+ * графе и на дорожной сетке для нескольких значений delta по сравнению с
+ * последовательным алгоритмом Дейкстры. Расстояния сверяются с Дейкстрой.
+ *
+ * Запуск
+ * delta_stepping_bench [log2 кол-ва вершин] [сторона сетки]
+ * По умолчанию случайный граф на 2^20 вершинах с 2^23 дугами весов
+ * [1, 100] и сетка 1000 x 1000. delta - средний вес дуги, умноженный
+ * на 1/4, 1 и 4.
+ */
+
+#include "graph/delta_stepping.hpp"
+#include "graph/generators.hpp"
+#include "graph/heaps.hpp"
+#include "graph/traversal.hpp"
+#include "graph/weighted_csr_graph.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+
+using Graph = graph::WeightedCsrGraph<std::uint32_t, std::uint32_t>;
+
+constexpr std::uint64_t MAX_WEIGHT = 100;
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+Graph BuildGraph(std::size_t vertices_count, std::span<const graph::WeightedEdge> edges) {
+    std::vector<Graph::Edge> narrow_edges;
+    narrow_edges.reserve(edges.size());
+    for (const auto& edge: edges) {
+        narrow_edges.push_back({static_cast<std::uint32_t>(edge.from), static_cast<std::uint32_t>(edge.to),
+                                static_cast<std::uint32_t>(edge.weight)});
+    }
+    return Graph(vertices_count, narrow_edges);
+}
+
+bool Measure(const std::string& name, const Graph& graph) {
+    std::uint64_t total_weight = 0;
+    for (std::uint32_t vertex = 0; vertex < graph.VerticesCount(); ++vertex) {
+        for (const auto& weight: graph.GetNextWeights(vertex)) {
+            total_weight += weight;
+        }
+    }
+    auto average_weight = std::max<std::uint64_t>(1, total_weight / std::max<std::size_t>(1, graph.EdgesCount()));
+
+    std::vector<std::uint64_t> expected;
+    auto time = MeasureSeconds([&] { expected = graph::Dijkstra<graph::RadixHeap>(graph, 0); });
+    std::cout << name << ",dijkstra_radix,1," << time << std::endl;
+
+    for (auto delta: {std::max<std::uint64_t>(1, average_weight / 4), average_weight, 4 * average_weight}) {
+        for (std::size_t threads_count: {1, 2, 4, 8, 16}) {
+            std::vector<std::uint64_t> distances;
+            time = MeasureSeconds([&] { distances = graph::DeltaStepping(graph, 0, delta, threads_count); });
+            if (distances != expected) {
+                std::cerr << "delta-stepping gave different distances on " << name << std::endl;
+                return false;
+            }
+            std::cout << name << ",delta_" << delta << "," << threads_count << "," << time << std::endl;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t scale = argc > 1 ? std::stoull(argv[1]) : 20;
+    std::size_t side = argc > 2 ? std::stoull(argv[2]) : 1000;
+
+    std::cout << "graph,algorithm,threads,seconds" << std::endl;
+
+    auto random_edges = graph::AddRandomWeights(graph::ErdosRenyiEdges(std::size_t{1} << scale,
+                                                                       std::size_t{8} << scale, 42),
+                                                MAX_WEIGHT, 43);
+    if (!Measure("random", BuildGraph(std::size_t{1} << scale, random_edges))) {
+        return EXIT_FAILURE;
+    }
+    random_edges = {};
+
+    if (!Measure("road", BuildGraph(side * side, graph::RoadEdges(side, side, 42)))) {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*
+ * Поддержка дерева кратчайших путей при изменении дорожной сети: пробки
+ * (вес дуги растёт вдвое), их рассасывание, перекрытие дороги и её открытие.
+ * Среднее время обновления и число вершин, у которых изменилось расстояние,
+ * по сравнению с полным пересчётом алгоритмом Дейкстры. В конце расстояния
+ * сверяются с Дейкстрой на итоговом графе.
+ *
+ * Запуск
+ * dynamic_sssp_bench [сторона сетки] [кол-во обновлений]
+ * По умолчанию сетка 1000 x 1000 и 10000 обновлений случайных дуг.
+ */
+
+#include "graph/dynamic_shortest_paths.hpp"
+#include "graph/generators.hpp"
+#include "graph/heaps.hpp"
+#include "graph/traversal.hpp"
+#include "graph/weighted_csr_graph.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+using RoadGraph = graph::WeightedCsrGraph<std::uint32_t, std::uint64_t>;
+using Edge = graph::DynamicShortestPaths::Edge;
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t side = argc > 1 ? std::stoull(argv[1]) : 1000;
+    std::size_t updates = argc > 2 ? std::stoull(argv[2]) : 10000;
+
+    // one edge per ordered pair, as `DynamicShortestPaths` keeps them.
+    std::vector<Edge> edges;
+    for (const auto& edge: graph::RoadEdges(side, side, 42)) {
+        edges.push_back({static_cast<std::uint32_t>(edge.from), static_cast<std::uint32_t>(edge.to), edge.weight});
+    }
+    std::sort(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs) {
+        return std::tie(lhs.from, lhs.to, lhs.weight) < std::tie(rhs.from, rhs.to, rhs.weight);
+    });
+    edges.erase(std::unique(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs) {
+        return lhs.from == rhs.from && lhs.to == rhs.to;
+    }), edges.end());
+
+    auto size = side * side;
+    std::mt19937_64 random(7);
+    std::uint64_t source = random() % size;
+
+    RoadGraph road(size, edges);
+    std::vector<std::uint64_t> expected;
+    auto dijkstra_time = MeasureSeconds([&] { expected = graph::Dijkstra<graph::RadixHeap>(road, source); });
+
+    std::optional<graph::DynamicShortestPaths> paths;
+    auto build_time = MeasureSeconds([&] { paths.emplace(size, edges, source); });
+
+    // current weights, `UNREACHABLE` for closed roads.
+    std::vector<std::uint64_t> weights(edges.size());
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        weights[i] = edges[i].weight;
+    }
+
+    std::size_t changed = 0;
+    auto updates_time = MeasureSeconds([&] {
+        for (std::size_t update = 0; update < updates; ++update) {
+            auto i = random() % edges.size();
+            const auto& edge = edges[i];
+            if (weights[i] == graph::UNREACHABLE) {
+                weights[i] = edge.weight;
+                changed += paths->SetEdge(edge.from, edge.to, weights[i]).size();
+            } else if (auto kind = random() % 3; kind == 0) {
+                weights[i] *= 2;
+                changed += paths->SetEdge(edge.from, edge.to, weights[i]).size();
+            } else if (kind == 1) {
+                weights[i] = edge.weight;
+                changed += paths->SetEdge(edge.from, edge.to, weights[i]).size();
+            } else {
+                weights[i] = graph::UNREACHABLE;
+                changed += paths->RemoveEdge(edge.from, edge.to).size();
+            }
+        }
+    });
+
+    std::vector<Edge> current;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        if (weights[i] != graph::UNREACHABLE) {
+            current.push_back({edges[i].from, edges[i].to, weights[i]});
+        }
+    }
+    expected = graph::Dijkstra<graph::RadixHeap>(RoadGraph(size, current), source);
+    for (std::size_t vertex = 0; vertex < size; ++vertex) {
+        if (paths->GetDistance(vertex) != expected[vertex]) {
+            std::cerr << "dynamic shortest paths gave a wrong distance" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    auto per_update = static_cast<double>(updates);
+    std::cout << "mode,seconds,changed_vertices" << std::endl;
+    std::cout << "dijkstra," << dijkstra_time << "," << size << std::endl;
+    std::cout << "build," << build_time << "," << size << std::endl;
+    std::cout << "update," << updates_time / per_update << "," << static_cast<double>(changed) / per_update
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+/*
+ * Сравнение представлений графа на синтетических нагрузках: построение,
+ * GetNextVertices / GetPrevVertices по всем вершинам, BFS и алгоритм Дейкстры
+ * (только для взвешенных представлений).
+ *
+ * Запуск
+ * graph_bench [csv|json] [log2 кол-ва вершин...]
+ * По умолчанию csv на 2^12 и 2^16 вершинах. Матрица смежности строится
+ * только до 2^14 вершин.
+ */
+
+#include "graph/arc_graph.hpp"
+#include "graph/compressed_graph.hpp"
+#include "graph/csr_graph.hpp"
+#include "graph/generators.hpp"
+#include "graph/list_graph.hpp"
+#include "graph/matrix_graph.hpp"
+#include "graph/set_graph.hpp"
+#include "graph/traversal.hpp"
+#include "graph/weighted_csr_graph.hpp"
+#include "graph/weighted_list_graph.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+constexpr std::size_t MAX_MATRIX_VERTICES = 1 << 14;
+constexpr std::size_t AVERAGE_DEGREE = 8;
+constexpr std::uint64_t MAX_WEIGHT = 100;
+
+using NarrowEdge = graph::BasicWeightedEdge<std::uint32_t, std::uint32_t>;
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Workload {
+    std::string name;
+    std::size_t vertices_count;
+    std::vector<graph::WeightedEdge> edges;
+};
+
+struct Record {
+    std::string workload;
+    std::size_t vertices_count;
+    std::size_t edges_count;
+    std::string representation;
+    double build_seconds;
+    double next_seconds;
+    double prev_seconds;
+    double bfs_seconds;
+    std::optional<double> dijkstra_seconds;
+};
+
+std::vector<Workload> GetWorkloads(std::size_t scale) {
+    auto vertices_count = std::size_t{1} << scale;
+    auto rows = std::size_t{1} << (scale / 2);
+    auto columns = vertices_count / rows;
+
+    std::vector<Workload> workloads;
+    workloads.push_back({"erdos_renyi", vertices_count, graph::AddRandomWeights(
+        graph::ErdosRenyiEdges(vertices_count, AVERAGE_DEGREE * vertices_count, 1), MAX_WEIGHT, 1)});
+    workloads.push_back({"rmat", vertices_count, graph::AddRandomWeights(
+        graph::RmatEdges(scale, AVERAGE_DEGREE * vertices_count, 2), MAX_WEIGHT, 2)});
+    workloads.push_back({"grid", vertices_count, graph::AddRandomWeights(
+        graph::GridEdges(rows, columns), MAX_WEIGHT, 3)});
+    workloads.push_back({"road", vertices_count, graph::RoadEdges(rows, columns, 4)});
+
+    return workloads;
+}
+
+// `build` returns the graph, queries run over every vertex and traversals start at vertex 0.
+template <typename Build>
+Record Measure(const Workload& workload, const std::string& representation, Build&& build) {
+    Record record{workload.name, workload.vertices_count, workload.edges.size(), representation, 0, 0, 0, 0, {}};
+
+    std::optional<decltype(build())> graph;
+    record.build_seconds = MeasureSeconds([&] {
+        graph.emplace(build());
+        if constexpr (requires { graph->Finalize(); }) {
+            graph->Finalize();
+        }
+    });
+
+    std::size_t checksum = 0;
+    record.next_seconds = MeasureSeconds([&] {
+        for (std::size_t vertex = 0; vertex < workload.vertices_count; ++vertex) {
+            checksum += graph->GetNextVertices(vertex).size();
+        }
+    });
+    record.prev_seconds = MeasureSeconds([&] {
+        for (std::size_t vertex = 0; vertex < workload.vertices_count; ++vertex) {
+            checksum -= graph->GetPrevVertices(vertex).size();
+        }
+    });
+    if (checksum != 0) {
+        std::cerr << representation << ": in-degrees do not match out-degrees" << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+
+    record.bfs_seconds = MeasureSeconds([&] {
+        checksum += graph::BFS(*graph, 0).size();
+    });
+    if constexpr (graph::WeightedAdjacencyGraph<std::remove_cvref_t<decltype(*graph)>>) {
+        record.dijkstra_seconds = MeasureSeconds([&] {
+            checksum += graph::Dijkstra(*graph, 0).size();
+        });
+    }
+
+    return record;
+}
+
+void PrintCsv(const std::vector<Record>& records) {
+    std::cout << "workload,vertices,edges,representation,build_seconds,next_seconds,prev_seconds,bfs_seconds,"
+                 "dijkstra_seconds" << std::endl;
+    for (const auto& record: records) {
+        std::cout << record.workload << "," << record.vertices_count << "," << record.edges_count << ","
+                  << record.representation << "," << record.build_seconds << "," << record.next_seconds << ","
+                  << record.prev_seconds << "," << record.bfs_seconds << ",";
+        if (record.dijkstra_seconds) {
+            std::cout << *record.dijkstra_seconds;
+        }
+        std::cout << std::endl;
+    }
+}
+
+void PrintJson(const std::vector<Record>& records) {
+    std::cout << "[" << std::endl;
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const auto& record = records[i];
+        std::cout << "  {\"workload\": \"" << record.workload << "\", \"vertices\": " << record.vertices_count
+                  << ", \"edges\": " << record.edges_count << ", \"representation\": \"" << record.representation
+                  << "\", \"build_seconds\": " << record.build_seconds << ", \"next_seconds\": " << record.next_seconds
+                  << ", \"prev_seconds\": " << record.prev_seconds << ", \"bfs_seconds\": " << record.bfs_seconds
+                  << ", \"dijkstra_seconds\": ";
+        if (record.dijkstra_seconds) {
+            std::cout << *record.dijkstra_seconds;
+        } else {
+            std::cout << "null";
+        }
+        std::cout << "}" << (i + 1 < records.size() ? "," : "") << std::endl;
+    }
+    std::cout << "]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string format = argc > 1 ? argv[1] : "csv";
+    if (format != "csv" && format != "json") {
+        std::cerr << "unknown format " << format << ", expected csv or json" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::size_t> scales;
+    for (int i = 2; i < argc; ++i) {
+        scales.push_back(std::stoull(argv[i]));
+    }
+    if (scales.empty()) {
+        scales = {12, 16};
+    }
+
+    std::vector<Record> records;
+    for (const auto& scale: scales) {
+        for (const auto& workload: GetWorkloads(scale)) {
+            auto edges = graph::RemoveWeights(workload.edges);
+            std::vector<NarrowEdge> narrow_edges;
+            for (const auto& edge: workload.edges) {
+                narrow_edges.push_back({static_cast<std::uint32_t>(edge.from), static_cast<std::uint32_t>(edge.to),
+                                        static_cast<std::uint32_t>(edge.weight)});
+            }
+
+            auto size = workload.vertices_count;
+            auto keep = graph::ReverseEdges::KEEP;
+            records.push_back(Measure(workload, "list", [&] { return graph::ListGraph(size, edges, keep); }));
+            records.push_back(Measure(workload, "set", [&] { return graph::SetGraph(size, edges, keep); }));
+            if (size <= MAX_MATRIX_VERTICES) {
+                records.push_back(Measure(workload, "matrix", [&] { return graph::MatrixGraph(size, edges); }));
+            }
+            records.push_back(Measure(workload, "arc", [&] { return graph::ArcGraph(size, edges); }));
+            records.push_back(Measure(workload, "csr", [&] { return graph::CsrGraph(size, edges); }));
+            records.push_back(Measure(workload, "compressed", [&] {
+                return graph::CompressedGraph(size, edges, keep);
+            }));
+            records.push_back(Measure(workload, "weighted_csr", [&] {
+                return graph::WeightedCsrGraph<std::uint32_t, std::uint32_t>(size, narrow_edges, keep);
+            }));
+            records.push_back(Measure(workload, "weighted_list", [&] {
+                graph::WeightedListGraph<std::uint32_t, std::uint32_t> graph(size, keep);
+                for (const auto& edge: narrow_edges) {
+                    graph.AddEdge(edge.from, edge.to, edge.weight);
+                }
+                return graph;
+            }));
+        }
+    }
+
+    if (format == "csv") {
+        PrintCsv(records);
+    } else {
+        PrintJson(records);
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Многоисточниковый BFS пачками по 64, 256 и 512 источников по сравнению
+ * с отдельным BFS из каждого источника на случайном неориентированном графе.
+ * Пачечный режим (batch) считает в посетителе сумму расстояний и сумму числа
+ * кратчайших путей для каждого источника, режим results возвращает расстояния
+ * и число путей до каждой вершины отдельно для каждого источника.
+ * Результаты сверяются с последовательным подсчетом.
+ *
+ * Запуск
+ * multi_source_bfs_bench [кол-во вершин] [кол-во ребер] [кол-во источников]
+ * По умолчанию 2^16 вершин, 2^19 ребер и 1024 источника.
+ */
+
+#include "graph/csr_graph.hpp"
+#include "graph/multi_source_bfs.hpp"
+#include "graph/parallel.hpp"
+#include "graph/paths_count.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// per-source sums of distances and of path counts to the reached vertices.
+struct Sums {
+    std::vector<std::uint64_t> distances;
+    std::vector<std::uint64_t> counts;
+};
+
+template <std::size_t Width>
+bool MeasureBatches(const graph::CsrGraph& graph, const std::vector<std::uint64_t>& sources, const Sums& expected) {
+    for (auto path_counts: {graph::PathCounts::SKIP, graph::PathCounts::KEEP}) {
+        for (auto threads_count: {std::size_t{1}, graph::DefaultThreadsCount()}) {
+            Sums sums{std::vector<std::uint64_t>(sources.size(), 0), std::vector<std::uint64_t>(sources.size(), 0)};
+            auto keep = path_counts == graph::PathCounts::KEEP;
+            auto time = MeasureSeconds([&] {
+                graph::MultiSourceBFS<Width>(graph, sources, [&](std::size_t first, std::uint64_t, std::uint64_t level,
+                                                                 const graph::SourceSet<Width>& reached,
+                                                                 std::span<const std::uint64_t> counts) {
+                    reached.ForEach([&](std::size_t i) {
+                        sums.distances[first + i] += level;
+                        if (keep) {
+                            sums.counts[first + i] += counts[i];
+                        }
+                    });
+                }, path_counts, threads_count);
+            });
+
+            if (sums.distances != expected.distances || (keep && sums.counts != expected.counts)) {
+                std::cerr << "ms_bfs_" << Width << " batches gave different results" << std::endl;
+                return false;
+            }
+            std::cout << "ms_bfs_" << Width << ",batch," << (keep ? "yes" : "no") << "," << threads_count << ","
+                      << time << std::endl;
+        }
+    }
+    return true;
+}
+
+bool MeasureResults(const graph::CsrGraph& graph, const std::vector<std::uint64_t>& sources,
+                    const std::vector<graph::ShortestPathsCount>& expected) {
+    for (auto path_counts: {graph::PathCounts::SKIP, graph::PathCounts::KEEP}) {
+        for (auto threads_count: {std::size_t{1}, graph::DefaultThreadsCount()}) {
+            std::vector<graph::ShortestPathsCount> results;
+            auto time = MeasureSeconds([&] {
+                results = graph::MultiSourceBFS(graph, sources, path_counts, threads_count);
+            });
+
+            auto keep = path_counts == graph::PathCounts::KEEP;
+            for (std::size_t i = 0; i < sources.size(); ++i) {
+                if (results[i].distances != expected[i].distances || (keep && results[i].counts != expected[i].counts)) {
+                    std::cerr << "ms_bfs_64 gave different results" << std::endl;
+                    return false;
+                }
+            }
+            std::cout << "ms_bfs_64,results," << (keep ? "yes" : "no") << "," << threads_count << "," << time
+                      << std::endl;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t vertex_count = argc > 1 ? std::stoull(argv[1]) : std::size_t{1} << 16;
+    std::size_t edges_count = argc > 2 ? std::stoull(argv[2]) : std::size_t{1} << 19;
+    std::size_t sources_count = argc > 3 ? std::stoull(argv[3]) : 1024;
+
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<std::uint64_t> random_vertex(0, vertex_count - 1);
+
+    std::vector<graph::CsrGraph::Edge> edges;
+    edges.reserve(2 * edges_count);
+    for (std::size_t i = 0; i < edges_count; ++i) {
+        auto from = random_vertex(random);
+        auto to = random_vertex(random);
+        edges.emplace_back(from, to);
+        edges.emplace_back(to, from);
+    }
+
+    graph::CsrGraph graph(vertex_count, edges);
+    edges = {};
+
+    std::vector<std::uint64_t> sources(sources_count);
+    for (auto& source: sources) {
+        source = random_vertex(random);
+    }
+
+    std::vector<graph::ShortestPathsCount> expected(sources_count);
+    auto serial_time = MeasureSeconds([&] {
+        for (std::size_t i = 0; i < sources_count; ++i) {
+            expected[i] = graph::CountShortestPathsSerial(graph, sources[i]);
+        }
+    });
+
+    Sums sums{std::vector<std::uint64_t>(sources_count, 0), std::vector<std::uint64_t>(sources_count, 0)};
+    for (std::size_t i = 0; i < sources_count; ++i) {
+        for (std::size_t vertex = 0; vertex < vertex_count; ++vertex) {
+            if (expected[i].distances[vertex] != graph::UNREACHABLE) {
+                sums.distances[i] += expected[i].distances[vertex];
+                sums.counts[i] += expected[i].counts[vertex];
+            }
+        }
+    }
+
+    std::cout << "mode,output,counts,threads,seconds" << std::endl;
+    std::cout << "serial_bfs,results,yes,1," << serial_time << std::endl;
+    auto ok = MeasureBatches<64>(graph, sources, sums)
+              && MeasureBatches<256>(graph, sources, sums)
+              && MeasureBatches<512>(graph, sources, sums)
+              && MeasureResults(graph, sources, expected);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,66 @@
+/*
+ * Сравнение последовательного и параллельного подсчета кратчайших путей
+ * на случайном неориентированном графе.
+ *
+ * Запуск
+ * paths_count_bench [кол-во вершин] [кол-во ребер] [кол-во потоков]
+ * По умолчанию 10^6 вершин и 5 * 10^6 ребер (10^7 дуг).
+ */
+
+#include "graph/csr_graph.hpp"
+#include "graph/paths_count.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t vertex_count = argc > 1 ? std::stoull(argv[1]) : 1'000'000;
+    std::size_t edges_count = argc > 2 ? std::stoull(argv[2]) : 5'000'000;
+    std::size_t threads_count = argc > 3 ? std::stoull(argv[3]) : graph::DefaultThreadsCount();
+
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<std::uint64_t> random_vertex(0, vertex_count - 1);
+
+    std::vector<graph::CsrGraph::Edge> edges;
+    edges.reserve(2 * edges_count);
+    for (std::size_t i = 0; i < edges_count; ++i) {
+        auto from = random_vertex(random);
+        auto to = random_vertex(random);
+        edges.emplace_back(from, to);
+        edges.emplace_back(to, from);
+    }
+
+    graph::CsrGraph graph(vertex_count, edges);
+    edges = {};
+
+    graph::ShortestPathsCount serial, parallel;
+    auto serial_time = MeasureSeconds([&] {
+        serial = graph::CountShortestPathsSerial(graph, 0);
+    });
+    auto parallel_time = MeasureSeconds([&] {
+        parallel = graph::CountShortestPaths(graph, 0, threads_count);
+    });
+
+    if (serial.distances != parallel.distances || serial.counts != parallel.counts) {
+        std::cerr << "parallel bfs result differs from serial one" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "vertices: " << graph.VerticesCount() << ", arcs: " << graph.EdgesCount()
+              << ", threads: " << threads_count << std::endl;
+    std::cout << "serial:   " << serial_time << " s" << std::endl;
+    std::cout << "parallel: " << parallel_time << " s (x" << serial_time / parallel_time << ")" << std::endl;
+}
@@ -0,0 +1,131 @@
+/*
+ * Время BFS и алгоритма Дейкстры на решетке со случайной нумерацией вершин
+ * до и после перенумерации.
+ *
+ * Запуск
+ * reorder_bench [сторона решетки]
+ * По умолчанию решетка 1000 x 1000.
+ */
+
+#include "graph/csr_graph.hpp"
+#include "graph/paths_count.hpp"
+#include "graph/reorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// weights depend on the original ids only, so every numbering describes the same graph.
+std::uint64_t GetWeight(std::uint64_t lhs, std::uint64_t rhs) {
+    auto hash = std::min(lhs, rhs) * 0x9E3779B97F4A7C15ULL ^ std::max(lhs, rhs);
+    return 1 + (hash >> 32) % 100;
+}
+
+std::vector<std::uint64_t> Dijkstra(const graph::CsrGraph& graph, const std::vector<std::uint64_t>& old_ids,
+                                    std::uint64_t source) {
+    std::vector<std::uint64_t> distances(graph.VerticesCount(), graph::UNREACHABLE);
+    std::priority_queue<std::pair<std::uint64_t, std::uint64_t>,
+                        std::vector<std::pair<std::uint64_t, std::uint64_t>>,
+                        std::greater<>> queue;
+
+    distances[source] = 0;
+    queue.emplace(0, source);
+    while (!queue.empty()) {
+        auto [distance, vertex] = queue.top();
+        queue.pop();
+        if (distance != distances[vertex]) {
+            continue;
+        }
+
+        for (const auto& next_vertex: graph.GetNextVerticesView(vertex)) {
+            auto next_distance = distance + GetWeight(old_ids[vertex], old_ids[next_vertex]);
+            if (next_distance < distances[next_vertex]) {
+                distances[next_vertex] = next_distance;
+                queue.emplace(next_distance, next_vertex);
+            }
+        }
+    }
+
+    return distances;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t side = argc > 1 ? std::stoull(argv[1]) : 1000;
+    std::size_t vertex_count = side * side;
+
+    std::vector<std::uint64_t> labels(vertex_count);
+    std::iota(labels.begin(), labels.end(), 0);
+    std::shuffle(labels.begin(), labels.end(), std::mt19937_64(42));
+
+    std::vector<graph::Edge> edges;
+    for (std::size_t row = 0; row < side; ++row) {
+        for (std::size_t column = 0; column < side; ++column) {
+            auto vertex = labels[row * side + column];
+            if (column + 1 < side) {
+                edges.emplace_back(vertex, labels[row * side + column + 1]);
+                edges.emplace_back(labels[row * side + column + 1], vertex);
+            }
+            if (row + 1 < side) {
+                edges.emplace_back(vertex, labels[(row + 1) * side + column]);
+                edges.emplace_back(labels[(row + 1) * side + column], vertex);
+            }
+        }
+    }
+
+    graph::CsrGraph original(vertex_count, edges, 1);
+    edges = {};
+
+    std::vector<std::uint64_t> identity(vertex_count);
+    std::iota(identity.begin(), identity.end(), 0);
+
+    std::vector<std::pair<std::string, graph::Permutation>> orders;
+    orders.emplace_back("random", graph::Permutation{identity, identity});
+    orders.emplace_back("degree", graph::DegreeOrder(original));
+    orders.emplace_back("rcm", graph::ReverseCuthillMcKeeOrder(original));
+    orders.emplace_back("hub", graph::HubClusterOrder(original));
+
+    std::vector<std::uint64_t> expected_bfs, expected_dijkstra;
+    std::cout << "order,bfs_seconds,dijkstra_seconds" << std::endl;
+    for (const auto& [name, permutation]: orders) {
+        auto relabeled = graph::CsrGraph(vertex_count, graph::RelabelEdges(original, permutation), 1);
+        auto source = permutation.new_ids[0];
+
+        graph::ShortestPathsCount bfs;
+        std::vector<std::uint64_t> dijkstra;
+        auto bfs_time = MeasureSeconds([&] {
+            bfs = graph::CountShortestPathsSerial(relabeled, source);
+        });
+        auto dijkstra_time = MeasureSeconds([&] {
+            dijkstra = Dijkstra(relabeled, permutation.old_ids, source);
+        });
+
+        auto bfs_distances = graph::RestoreOrder(bfs.distances, permutation);
+        auto dijkstra_distances = graph::RestoreOrder(dijkstra, permutation);
+        if (expected_bfs.empty()) {
+            expected_bfs = bfs_distances;
+            expected_dijkstra = dijkstra_distances;
+        } else if (bfs_distances != expected_bfs || dijkstra_distances != expected_dijkstra) {
+            std::cerr << name << " order changed the distances" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << name << "," << bfs_time << "," << dijkstra_time << std::endl;
+    }
+}
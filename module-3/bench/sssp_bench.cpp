@@ -0,0 +1,190 @@
+/*
+ * Время алгоритма Дейкстры с разными очередями с приоритетом на дорожной сети
+ * (в том числе с очередью из корзин Дайла и 0-1 BFS на весах 0 и 1)
+ * и запросов расстояния между парами вершин: полный поиск, поиск с остановкой
+ * в конечной вершине (в том числе с состоянием, общим для всех запросов),
+ * двунаправленный поиск и ALT (A* с оценками через 16 ориентиров, выбранных
+ * двумя способами).
+ *
+ * Запуск
+ * sssp_bench [сторона сетки] [кол-во запусков]
+ * По умолчанию сетка 1000 x 1000 (10^6 вершин, около 3.8 * 10^6 дуг, порядок
+ * размера дорожной сети штата) и 4 запуска из случайных вершин (пар вершин).
+ */
+
+#include "graph/generators.hpp"
+#include "graph/heaps.hpp"
+#include "graph/landmarks.hpp"
+#include "graph/query_context.hpp"
+#include "graph/traversal.hpp"
+#include "graph/weighted_csr_graph.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+using RoadGraph = graph::WeightedCsrGraph<std::uint32_t, std::uint32_t>;
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// counts settled vertices.
+struct SettledCounter: graph::TraversalVisitor {
+    void DiscoverVertex(std::uint64_t) {
+        ++settled;
+    }
+
+    std::size_t settled = 0;
+};
+
+template <typename Queue>
+bool MeasureQueue(const std::string& name, const RoadGraph& graph, const std::vector<std::uint64_t>& sources,
+                  std::vector<std::vector<std::uint64_t>>& expected) {
+    std::vector<std::vector<std::uint64_t>> distances(sources.size());
+    auto time = MeasureSeconds([&] {
+        for (std::size_t i = 0; i < sources.size(); ++i) {
+            distances[i] = graph::Dijkstra<Queue>(graph, sources[i]);
+        }
+    });
+
+    if (expected.empty()) {
+        expected = std::move(distances);
+    } else if (distances != expected) {
+        std::cerr << name << " gave different distances" << std::endl;
+        return false;
+    }
+
+    std::cout << name << "," << time / static_cast<double>(sources.size()) << std::endl;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t side = argc > 1 ? std::stoull(argv[1]) : 1000;
+    std::size_t runs = argc > 2 ? std::stoull(argv[2]) : 4;
+
+    std::vector<RoadGraph::Edge> edges;
+    for (const auto& edge: graph::RoadEdges(side, side, 42)) {
+        edges.push_back({static_cast<std::uint32_t>(edge.from), static_cast<std::uint32_t>(edge.to),
+                         static_cast<std::uint32_t>(edge.weight)});
+    }
+    RoadGraph road(side * side, edges, graph::ReverseEdges::KEEP);
+
+    std::mt19937_64 random(7);
+    std::vector<std::uint64_t> sources(runs);
+    for (auto& source: sources) {
+        source = random() % road.VerticesCount();
+    }
+
+    std::vector<std::vector<std::uint64_t>> expected;
+    std::cout << "queue,seconds_per_query" << std::endl;
+    auto ok = MeasureQueue<graph::LazyHeap>("lazy_binary", road, sources, expected)
+              && MeasureQueue<graph::IndexedHeap<2>>("indexed_2", road, sources, expected)
+              && MeasureQueue<graph::IndexedHeap<4>>("indexed_4", road, sources, expected)
+              && MeasureQueue<graph::IndexedHeap<8>>("indexed_8", road, sources, expected)
+              && MeasureQueue<graph::RadixHeap>("radix", road, sources, expected)
+              && MeasureQueue<graph::BucketQueue>("bucket", road, sources, expected);
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    // the same grid with weights 0 and 1, where 0-1 bfs needs no priority queue at all.
+    auto unit_edges = edges;
+    for (auto& edge: unit_edges) {
+        edge.weight %= 2;
+    }
+    RoadGraph unit_road(side * side, unit_edges);
+    std::vector<std::vector<std::uint64_t>> unit_expected;
+    std::cout << std::endl << "zero_one_queue,seconds_per_query" << std::endl;
+    ok = MeasureQueue<graph::RadixHeap>("radix", unit_road, sources, unit_expected)
+         && MeasureQueue<graph::BucketQueue>("bucket", unit_road, sources, unit_expected);
+    std::vector<std::vector<std::uint64_t>> unit_distances(runs);
+    auto unit_time = MeasureSeconds([&] {
+        for (std::size_t i = 0; i < runs; ++i) {
+            unit_distances[i] = graph::ZeroOneBFS(unit_road, sources[i]);
+        }
+    });
+    if (!ok || unit_distances != unit_expected) {
+        std::cerr << "zero_one_bfs gave different distances" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "zero_one_bfs," << unit_time / static_cast<double>(runs) << std::endl;
+
+    std::vector<std::uint64_t> targets(runs);
+    for (auto& target: targets) {
+        target = random() % road.VerticesCount();
+    }
+
+    auto measure_pairs = [&](const std::string& name, auto&& query) {
+        SettledCounter counter;
+        std::vector<std::uint64_t> distances(runs);
+        auto time = MeasureSeconds([&] {
+            for (std::size_t i = 0; i < runs; ++i) {
+                distances[i] = query(sources[i], targets[i], counter);
+            }
+        });
+
+        for (std::size_t i = 0; i < runs; ++i) {
+            if (distances[i] != expected[i][targets[i]]) {
+                std::cerr << name << " gave a wrong distance" << std::endl;
+                return false;
+            }
+        }
+
+        auto per_query = static_cast<double>(runs);
+        std::cout << name << "," << time / per_query << "," << static_cast<double>(counter.settled) / per_query
+                  << std::endl;
+        return true;
+    };
+
+    // one context for all queries, so a query does not allocate and initialize O(V) arrays.
+    graph::QueryContext<> context(road.VerticesCount());
+    std::cout << std::endl << "mode,seconds_per_query,settled_per_query" << std::endl;
+    ok = measure_pairs("full", [&](std::uint64_t from, std::uint64_t to, SettledCounter& counter) {
+             return graph::Dijkstra(road, from, counter)[to];
+         })
+         && measure_pairs("early_exit", [&](std::uint64_t from, std::uint64_t to, SettledCounter& counter) {
+             return graph::DijkstraDistance(road, from, to, counter);
+         })
+         && measure_pairs("early_exit_context", [&](std::uint64_t from, std::uint64_t to, SettledCounter& counter) {
+             return graph::DijkstraDistance(road, from, to, context, counter);
+         })
+         && measure_pairs("bidirectional", [&](std::uint64_t from, std::uint64_t to, SettledCounter& counter) {
+             return graph::BidirectionalDijkstraDistance(road, from, to, counter);
+         })
+         && measure_pairs("bidirectional_radix", [&](std::uint64_t from, std::uint64_t to, SettledCounter& counter) {
+             return graph::BidirectionalDijkstraDistance<graph::RadixHeap>(road, from, to, counter);
+         });
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    constexpr std::size_t LANDMARKS_COUNT = 16;
+    std::vector<std::pair<std::string, graph::Landmarks>> landmarks;
+    std::cout << std::endl << "selection,preprocessing_seconds" << std::endl;
+    for (auto [name, selection]: {std::pair{"farthest", graph::LandmarkSelection::FARTHEST},
+                                  std::pair{"avoid", graph::LandmarkSelection::AVOID}}) {
+        auto start = std::chrono::steady_clock::now();
+        landmarks.emplace_back(name, graph::Landmarks(road, LANDMARKS_COUNT, selection, 11));
+        std::cout << name << "," << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                  << std::endl;
+    }
+
+    std::cout << std::endl << "mode,seconds_per_query,settled_per_query" << std::endl;
+    for (const auto& [name, alt]: landmarks) {
+        ok = ok && measure_pairs("alt_" + name, [&](std::uint64_t from, std::uint64_t to, SettledCounter& counter) {
+            return graph::AltDistance(road, alt, from, to, counter);
+        });
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
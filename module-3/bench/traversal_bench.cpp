@@ -0,0 +1,175 @@
+/*
+ * Время BFS и DFS через шаблонный обход с конкретным типом графа и через
+ * виртуальный интерфейс `IGraph` для каждого представления графа, и время
+ * алгоритма Дейкстры на взвешенных представлениях разной ширины.
+ *
+ * Запуск
+ * traversal_bench [кол-во вершин] [кол-во ребер]
+ * По умолчанию 2^18 вершин и 2^22 ребер. Матрица смежности строится
+ * на 2^14 вершинах с той же средней степенью.
+ */
+
+#include "graph/arc_graph.hpp"
+#include "graph/compressed_graph.hpp"
+#include "graph/csr_graph.hpp"
+#include "graph/list_graph.hpp"
+#include "graph/matrix_graph.hpp"
+#include "graph/set_graph.hpp"
+#include "graph/traversal.hpp"
+#include "graph/weighted_csr_graph.hpp"
+#include "graph/weighted_list_graph.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+
+constexpr std::size_t MATRIX_VERTICES = 1 << 14;
+constexpr std::size_t RUNS = 4;
+
+template <typename Function>
+double MeasureSeconds(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// checksum of the traversal, keeps the hooks from being optimized away.
+struct CountingVisitor: graph::TraversalVisitor {
+    void TreeEdge(std::uint64_t from, std::uint64_t to) {
+        checksum += from ^ to;
+    }
+
+    std::uint64_t checksum = 0;
+};
+
+// the traversals below are instantiated once for `IGraph`, every call goes through the vtable.
+[[gnu::noinline]] std::uint64_t VirtualBFS(const graph::IGraph& graph, std::uint64_t source) {
+    CountingVisitor visitor;
+    graph::BFS(graph, source, visitor);
+    return visitor.checksum;
+}
+
+[[gnu::noinline]] std::uint64_t VirtualDFS(const graph::IGraph& graph, std::uint64_t source) {
+    CountingVisitor visitor;
+    graph::DFS(graph, source, visitor);
+    return visitor.checksum;
+}
+
+template <typename Graph>
+bool MeasureRepresentation(const std::string& name, const Graph& graph) {
+    std::uint64_t static_bfs = 0, virtual_bfs = 0, static_dfs = 0, virtual_dfs = 0;
+
+    // untimed warm-up.
+    graph::BFS(graph, 0);
+
+    auto static_bfs_time = MeasureSeconds([&] {
+        for (std::size_t source = 0; source < RUNS; ++source) {
+            CountingVisitor visitor;
+            graph::BFS(graph, source, visitor);
+            static_bfs += visitor.checksum;
+        }
+    });
+    auto virtual_bfs_time = MeasureSeconds([&] {
+        for (std::size_t source = 0; source < RUNS; ++source) {
+            virtual_bfs += VirtualBFS(graph, source);
+        }
+    });
+    auto static_dfs_time = MeasureSeconds([&] {
+        for (std::size_t source = 0; source < RUNS; ++source) {
+            CountingVisitor visitor;
+            graph::DFS(graph, source, visitor);
+            static_dfs += visitor.checksum;
+        }
+    });
+    auto virtual_dfs_time = MeasureSeconds([&] {
+        for (std::size_t source = 0; source < RUNS; ++source) {
+            virtual_dfs += VirtualDFS(graph, source);
+        }
+    });
+
+    if (static_bfs != virtual_bfs || static_dfs != virtual_dfs) {
+        std::cerr << name << ": static and virtual traversals differ" << std::endl;
+        return false;
+    }
+
+    std::cout << name << "," << static_bfs_time << "," << virtual_bfs_time << ","
+              << static_dfs_time << "," << virtual_dfs_time << std::endl;
+    return true;
+}
+
+std::vector<graph::Edge> GetRandomEdges(std::size_t vertex_count, std::size_t edges_count) {
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<std::uint64_t> random_vertex(0, vertex_count - 1);
+
+    std::vector<graph::Edge> edges(edges_count);
+    for (auto& [from, to]: edges) {
+        from = random_vertex(random);
+        to = random_vertex(random);
+    }
+
+    return edges;
+}
+
+template <typename Graph>
+void MeasureDijkstra(const std::string& name, const Graph& graph) {
+    std::uint64_t checksum = 0;
+    auto time = MeasureSeconds([&] {
+        for (std::size_t source = 0; source < RUNS; ++source) {
+            for (const auto& distance: graph::Dijkstra(graph, source)) {
+                checksum += distance != graph::UNREACHABLE ? distance : 0;
+            }
+        }
+    });
+
+    std::cout << name << "," << time << "," << checksum << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t vertex_count = argc > 1 ? std::stoull(argv[1]) : 1 << 18;
+    std::size_t edges_count = argc > 2 ? std::stoull(argv[2]) : 1 << 22;
+
+    auto edges = GetRandomEdges(vertex_count, edges_count);
+    auto matrix_vertices = std::min(vertex_count, MATRIX_VERTICES);
+    auto matrix_edges = GetRandomEdges(matrix_vertices, edges_count / vertex_count * matrix_vertices);
+
+    std::cout << "representation,bfs_static_seconds,bfs_virtual_seconds,dfs_static_seconds,dfs_virtual_seconds"
+              << std::endl;
+    auto ok = MeasureRepresentation("list", graph::ListGraph(vertex_count, edges))
+              && MeasureRepresentation("set", graph::SetGraph(vertex_count, edges))
+              && MeasureRepresentation("arc", graph::ArcGraph(vertex_count, edges))
+              && MeasureRepresentation("csr", graph::CsrGraph(vertex_count, edges))
+              && MeasureRepresentation("compressed", graph::CompressedGraph(vertex_count, edges))
+              && MeasureRepresentation("matrix_" + std::to_string(matrix_vertices),
+                                       graph::MatrixGraph(matrix_vertices, matrix_edges));
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937_64 random(7);
+    std::uniform_int_distribution<std::uint32_t> random_weight(1, 100);
+    std::vector<graph::BasicWeightedEdge<std::uint32_t, std::uint32_t>> narrow_edges;
+    std::vector<graph::BasicWeightedEdge<std::uint64_t, std::uint64_t>> wide_edges;
+    for (const auto& [from, to]: edges) {
+        auto weight = random_weight(random);
+        narrow_edges.push_back({static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to), weight});
+        wide_edges.push_back({from, to, weight});
+    }
+
+    std::cout << std::endl << "representation,dijkstra_seconds,checksum" << std::endl;
+    MeasureDijkstra("weighted_csr_32",
+                    graph::WeightedCsrGraph<std::uint32_t, std::uint32_t>(vertex_count, narrow_edges));
+    MeasureDijkstra("weighted_csr_64",
+                    graph::WeightedCsrGraph<std::uint64_t, std::uint64_t>(vertex_count, wide_edges));
+
+    graph::WeightedListGraph<std::uint32_t, std::uint32_t> weighted_list(vertex_count);
+    for (const auto& edge: narrow_edges) {
+        weighted_list.AddEdge(edge.from, edge.to, edge.weight);
+    }
+    MeasureDijkstra("weighted_list_32", weighted_list);
+}
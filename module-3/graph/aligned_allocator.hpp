@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+
+namespace graph {
+
+// allocator handing out storage aligned to `Alignment` bytes, e.g. to a cache line.
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* pointer, std::size_t) {
+        ::operator delete(pointer, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator == (const AlignedAllocator<U, Alignment>&) const {
+        return true;
+    }
+};
+
+}  // namespace graph
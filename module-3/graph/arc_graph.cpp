@@ -1,7 +1,11 @@
 #include "arc_graph.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <utility>
 
 
 namespace graph {
@@ -11,16 +15,82 @@ ArcGraph::ArcGraph(std::size_t size): vertices_count_(size) {
 
 ArcGraph::ArcGraph(const IGraph& graph): vertices_count_(graph.VerticesCount()) {
     for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
-        for (const auto& to: graph.GetNextVertices(from)) {
+        graph.ForEachNextVertex(from, [this, from](std::uint64_t to) {
             edges_.emplace_back(from, to);
-        }
+        });
     }
+
+    finalized_ = false;
+    Finalize();
+}
+
+ArcGraph::ArcGraph(std::size_t size, std::span<const Edge> edges)
+    : vertices_count_(size), edges_(edges.begin(), edges.end()), finalized_(false) {
+    Finalize();
+}
+
+ArcGraph::ArcGraph(const ArcGraph& other): vertices_count_(other.vertices_count_) {
+    other.Finalize();
+    edges_ = other.edges_;
+    edges_by_target_ = other.edges_by_target_;
+}
+
+ArcGraph& ArcGraph::operator = (const ArcGraph& other) {
+    if (this != &other) {
+        other.Finalize();
+        vertices_count_ = other.vertices_count_;
+        edges_ = other.edges_;
+        edges_by_target_ = other.edges_by_target_;
+        finalized_ = true;
+    }
+    return *this;
+}
+
+ArcGraph::ArcGraph(ArcGraph&& other) noexcept
+    : vertices_count_(other.vertices_count_), edges_(std::move(other.edges_)),
+      edges_by_target_(std::move(other.edges_by_target_)), finalized_(other.finalized_.load()) {
+}
+
+ArcGraph& ArcGraph::operator = (ArcGraph&& other) noexcept {
+    if (this != &other) {
+        vertices_count_ = other.vertices_count_;
+        edges_ = std::move(other.edges_);
+        edges_by_target_ = std::move(other.edges_by_target_);
+        finalized_ = other.finalized_.load();
+    }
+    return *this;
 }
 
 void ArcGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
     assert(from < VerticesCount());
     assert(to < VerticesCount());
     edges_.emplace_back(from, to);
+    finalized_ = false;
+}
+
+void ArcGraph::Finalize() const {
+    if (finalized_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::lock_guard lock(finalize_mutex_);
+    if (finalized_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    std::sort(edges_.begin(), edges_.end());
+
+    edges_by_target_.resize(edges_.size());
+    std::iota(edges_by_target_.begin(), edges_by_target_.end(), 0);
+    std::stable_sort(edges_by_target_.begin(), edges_by_target_.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return edges_[lhs].second < edges_[rhs].second;
+    });
+
+    finalized_.store(true, std::memory_order_release);
+}
+
+[[nodiscard]] bool ArcGraph::IsFinalized() const {
+    return finalized_.load(std::memory_order_acquire);
 }
 
 [[nodiscard]] std::size_t ArcGraph::VerticesCount() const {
@@ -28,29 +98,29 @@ void ArcGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
 }
 
 [[nodiscard]] std::vector<std::uint64_t> ArcGraph::GetNextVertices(std::uint64_t vertex) const {
-    assert(vertex < VerticesCount());
-
     std::vector<std::uint64_t> next_vertices;
-    for (const auto& edge: edges_) {
-        if (edge.first == vertex) {
-            next_vertices.push_back(edge.second);
-        }
-    }
+    ForEachNextVertex(vertex, [&next_vertices](std::uint64_t to) {
+        next_vertices.push_back(to);
+    });
 
     return next_vertices;
 }
 
 [[nodiscard]] std::vector<std::uint64_t> ArcGraph::GetPrevVertices(std::uint64_t vertex) const {
-    assert(vertex < VerticesCount());
-
     std::vector<std::uint64_t> prev_vertices;
-    for (const auto& edge: edges_) {
-        if (edge.second == vertex) {
-            prev_vertices.push_back(edge.first);
-        }
-    }
+    ForEachPrevVertex(vertex, [&prev_vertices](std::uint64_t from) {
+        prev_vertices.push_back(from);
+    });
 
     return prev_vertices;
 }
 
+void ArcGraph::ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachNextVertex<VertexVisitor&>(vertex, visitor);
+}
+
+void ArcGraph::ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachPrevVertex<VertexVisitor&>(vertex, visitor);
+}
+
 }  // namespace graph
@@ -1,32 +1,101 @@
 #pragma once
 
 #include "base.hpp"
+#include "edge_list.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cstdint>
+#include <mutex>
+#include <span>
 #include <utility>
+#include <vector>
 
 
 namespace graph {
 
+// plain edge list. queries sort it by source once and index it by target, see `Finalize`.
 class ArcGraph: public IGraph {
-    using Edge = std::pair<std::uint64_t, std::uint64_t>;
-
  public:
     explicit ArcGraph(std::size_t size);
 
     explicit ArcGraph(const IGraph& graph);
 
+    ArcGraph(std::size_t size, std::span<const Edge> edges);
+
+    // copies are finalized, `other` is finalized first if needed.
+    ArcGraph(const ArcGraph& other);
+    ArcGraph& operator = (const ArcGraph& other);
+
+    ArcGraph(ArcGraph&& other) noexcept;
+    ArcGraph& operator = (ArcGraph&& other) noexcept;
+
+    // O(1), invalidates the index built by `Finalize`.
     void AddEdge(std::uint64_t from, std::uint64_t to) override;
 
+    // sorting edges by source and building a permutation of them sorted by target,
+    // so neighbour queries cost O(log E + degree). the constructors call it, after
+    // `AddEdge` the first query does. concurrent queries are safe: one of them builds
+    // the index under a mutex and the rest wait for it.
+    void Finalize() const;
+
+    [[nodiscard]] bool IsFinalized() const;
+
     [[nodiscard]] std::size_t VerticesCount() const override;
 
     [[nodiscard]] std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const override;
 
     [[nodiscard]] std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const override;
 
+    void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    template <typename Visitor>
+    void ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    template <typename Visitor>
+    void ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
  private:
     std::size_t vertices_count_;
-    std::vector<Edge> edges_;
+    mutable std::vector<Edge> edges_;
+    mutable std::vector<std::size_t> edges_by_target_;
+    // stored with release once the index is built, so a query seeing it set sees the index.
+    mutable std::atomic<bool> finalized_ = true;
+    mutable std::mutex finalize_mutex_;
 };
 
+template <typename Visitor>
+void ArcGraph::ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+    Finalize();
+
+    auto first = std::lower_bound(edges_.begin(), edges_.end(), vertex, [](const Edge& edge, std::uint64_t from) {
+        return edge.first < from;
+    });
+    for (; first != edges_.end() && first->first == vertex; ++first) {
+        visitor(first->second);
+    }
+}
+
+template <typename Visitor>
+void ArcGraph::ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+    Finalize();
+
+    auto first = std::lower_bound(
+        edges_by_target_.begin(),
+        edges_by_target_.end(),
+        vertex,
+        [this](std::size_t edge, std::uint64_t to) {
+            return edges_[edge].second < to;
+        }
+    );
+    for (; first != edges_by_target_.end() && edges_[*first].second == vertex; ++first) {
+        visitor(edges_[*first].first);
+    }
+}
+
 }  // namespace graph
@@ -2,10 +2,49 @@
 
 #include <vector>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
 
 
 namespace graph {
 
+// distance of a vertex not reachable from the source.
+constexpr std::uint64_t UNREACHABLE = std::numeric_limits<std::uint64_t>::max();
+
+// non-owning reference to a callable accepting a vertex. it is only valid while
+// the referenced callable is alive, which is enough for passing lambdas into
+// `ForEach*` calls.
+class VertexVisitor {
+ public:
+    template <typename Callable>
+        requires (!std::is_same_v<std::remove_cvref_t<Callable>, VertexVisitor>
+                  && std::is_invocable_v<Callable&, std::uint64_t>)
+    VertexVisitor(Callable&& callable)
+        : callable_(const_cast<void*>(static_cast<const void*>(std::addressof(callable)))),
+          invoke_([](void* callable, std::uint64_t vertex) {
+              (*static_cast<std::remove_reference_t<Callable>*>(callable))(vertex);
+          }) {
+    }
+
+    void operator()(std::uint64_t vertex) const {
+        invoke_(callable_, vertex);
+    }
+
+ private:
+    void* callable_;
+    void (*invoke_)(void*, std::uint64_t);
+};
+
+
+// whether a representation keeps in-edges next to out-edges. keeping them costs
+// memory for a second copy of the edges, but makes `GetPrevVertices` O(in-degree).
+enum class ReverseEdges {
+    SKIP,
+    KEEP
+};
+
+
 struct IGraph {
     virtual ~IGraph() {}
 
@@ -16,7 +55,20 @@ struct IGraph {
 
     [[nodiscard]] virtual std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const = 0;
     [[nodiscard]] virtual std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const = 0;
+
+    // calling `visitor` for every neighbour without allocating a vector for them.
+    // implementations override these, the defaults only fall back to `Get*Vertices`.
+    virtual void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+        for (const auto& next_vertex: GetNextVertices(vertex)) {
+            visitor(next_vertex);
+        }
+    }
+
+    virtual void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+        for (const auto& prev_vertex: GetPrevVertices(vertex)) {
+            visitor(prev_vertex);
+        }
+    }
 };
 
 }  // namespace graph
-
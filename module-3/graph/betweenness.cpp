@@ -0,0 +1,132 @@
+#include "betweenness.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+
+namespace graph {
+
+namespace {
+
+// brandes from each of `sources`, every dependency multiplied by `scale`.
+std::vector<double> AccumulateDependencies(const CsrGraph& graph, std::span<const std::uint64_t> sources,
+                                           double scale, std::size_t threads_count) {
+    auto vertices_count = graph.VerticesCount();
+    threads_count = std::clamp<std::size_t>(threads_count, 1, std::max<std::size_t>(sources.size(), 1));
+
+    struct State {
+        std::vector<std::uint64_t> distances;
+        // path counts as doubles: they grow exponentially with the distance and only their ratios matter.
+        std::vector<double> counts;
+        std::vector<double> dependencies;
+        // vertices in the bfs order, which doubles as the queue.
+        std::vector<std::uint64_t> order;
+        std::vector<double> scores;
+    };
+    std::vector<State> states(threads_count);
+
+    ParallelFor(0, sources.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        auto& [distances, counts, dependencies, order, scores] = states[thread];
+        // a thread may get several blocks, its state is allocated by the first one.
+        if (scores.empty()) {
+            distances.assign(vertices_count, UNREACHABLE);
+            counts.assign(vertices_count, 0);
+            dependencies.assign(vertices_count, 0);
+            scores.assign(vertices_count, 0);
+        }
+
+        for (auto i = begin; i < end; ++i) {
+            auto source = sources[i];
+            assert(source < vertices_count);
+
+            // only the vertices reached from the previous source are reset.
+            for (const auto& vertex: order) {
+                distances[vertex] = UNREACHABLE;
+                counts[vertex] = 0;
+                dependencies[vertex] = 0;
+            }
+            order.clear();
+
+            distances[source] = 0;
+            counts[source] = 1;
+            order.push_back(source);
+            for (std::size_t head = 0; head < order.size(); ++head) {
+                auto vertex = order[head];
+                for (const auto& next_vertex: graph.GetNextVerticesView(vertex)) {
+                    if (distances[next_vertex] == UNREACHABLE) {
+                        distances[next_vertex] = distances[vertex] + 1;
+                        order.push_back(next_vertex);
+                    }
+                    if (distances[next_vertex] == distances[vertex] + 1) {
+                        counts[next_vertex] += counts[vertex];
+                    }
+                }
+            }
+
+            // a vertex pulls from its successors on the next level, so no predecessor lists are kept.
+            for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                auto vertex = *it;
+                for (const auto& next_vertex: graph.GetNextVerticesView(vertex)) {
+                    if (distances[next_vertex] == distances[vertex] + 1) {
+                        dependencies[vertex] += counts[vertex] / counts[next_vertex] * (1 + dependencies[next_vertex]);
+                    }
+                }
+                if (vertex != source) {
+                    scores[vertex] += dependencies[vertex];
+                }
+            }
+        }
+    }, 1);
+
+    std::vector<double> scores(vertices_count, 0);
+    ParallelFor(0, vertices_count, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto vertex = begin; vertex < end; ++vertex) {
+            for (const auto& state: states) {
+                if (!state.scores.empty()) {
+                    scores[vertex] += state.scores[vertex];
+                }
+            }
+            scores[vertex] *= scale;
+        }
+    });
+
+    return scores;
+}
+
+}  // namespace
+
+[[nodiscard]] std::vector<double> BetweennessCentrality(const CsrGraph& graph, std::size_t threads_count) {
+    std::vector<std::uint64_t> sources(graph.VerticesCount());
+    std::iota(sources.begin(), sources.end(), 0);
+    return AccumulateDependencies(graph, sources, 1, threads_count);
+}
+
+[[nodiscard]] std::vector<double> ApproximateBetweennessCentrality(const CsrGraph& graph, std::size_t samples,
+                                                                   std::uint64_t seed, std::size_t threads_count) {
+    auto vertices_count = graph.VerticesCount();
+    if (samples == 0 || samples > vertices_count) {
+        throw std::invalid_argument("betweenness needs from 1 to " + std::to_string(vertices_count)
+                                    + " samples, " + std::to_string(samples) + " given");
+    }
+
+    // the first `samples` positions of a partial fisher-yates shuffle.
+    std::mt19937_64 random(seed);
+    std::vector<std::uint64_t> sources(vertices_count);
+    std::iota(sources.begin(), sources.end(), 0);
+    for (std::size_t i = 0; i < samples; ++i) {
+        std::uniform_int_distribution<std::size_t> pick(i, vertices_count - 1);
+        std::swap(sources[i], sources[pick(random)]);
+    }
+    sources.resize(samples);
+
+    return AccumulateDependencies(graph, sources, static_cast<double>(vertices_count) / static_cast<double>(samples),
+                                  threads_count);
+}
+
+}  // namespace graph
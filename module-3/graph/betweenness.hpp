@@ -0,0 +1,29 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace graph {
+
+// betweenness centrality by Brandes' algorithm: for every source a bfs counts shortest paths
+// (as `CountShortestPaths`) and a sweep in the reverse bfs order accumulates the dependency
+// of the source on every vertex. a score is the sum of the dependencies over the sources, so
+// an undirected graph stored as both arcs scores every pair twice.
+//
+// sources are spread over the threads. every thread keeps O(V) state: distances, path counts,
+// dependencies, the bfs order and its own scores, which are summed at the end.
+[[nodiscard]] std::vector<double> BetweennessCentrality(const CsrGraph& graph,
+                                                        std::size_t threads_count = DefaultThreadsCount());
+
+// the same estimated from `samples` distinct random sources and scaled by V / `samples`
+// (Bader et al.), which is exact when `samples` is V. throws `std::invalid_argument` unless
+// `samples` is in [1, V].
+[[nodiscard]] std::vector<double> ApproximateBetweennessCentrality(const CsrGraph& graph, std::size_t samples,
+                                                                   std::uint64_t seed = 0,
+                                                                   std::size_t threads_count = DefaultThreadsCount());
+
+}  // namespace graph
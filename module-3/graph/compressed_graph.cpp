@@ -0,0 +1,173 @@
+#include "compressed_graph.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+
+namespace graph {
+
+namespace {
+
+static_assert(std::endian::native == std::endian::little, "encoded values are read as little-endian words");
+
+// decoding always loads a whole word, so the data ends with this many spare bytes.
+constexpr std::size_t PADDING = sizeof(std::uint64_t) - 1;
+
+std::uint8_t GetLengthCode(std::uint64_t value) {
+    if (value < (std::uint64_t{1} << 8)) {
+        return 0;
+    }
+    if (value < (std::uint64_t{1} << 16)) {
+        return 1;
+    }
+    if (value < (std::uint64_t{1} << 32)) {
+        return 2;
+    }
+    return 3;
+}
+
+std::size_t GetVarintBytes(std::uint64_t value) {
+    std::size_t bytes = 1;
+    for (; value >= 0x80; value >>= 7) {
+        ++bytes;
+    }
+
+    return bytes;
+}
+
+std::size_t GetEncodedBytes(std::span<const std::uint64_t> sorted_vertices) {
+    auto bytes = GetVarintBytes(sorted_vertices.size()) + (sorted_vertices.size() + 3) / 4;
+    std::uint64_t previous = 0;
+    for (const auto& vertex: sorted_vertices) {
+        bytes += std::size_t{1} << GetLengthCode(vertex - previous);
+        previous = vertex;
+    }
+
+    return bytes;
+}
+
+void EncodeBlock(std::span<const std::uint64_t> sorted_vertices, std::uint8_t* output) {
+    auto degree = sorted_vertices.size();
+    for (; degree >= 0x80; degree >>= 7) {
+        *output++ = static_cast<std::uint8_t>(degree | 0x80);
+    }
+    *output++ = static_cast<std::uint8_t>(degree);
+
+    auto* control = output;
+    auto* data = output + (sorted_vertices.size() + 3) / 4;
+    std::fill(control, data, 0);
+
+    std::uint64_t previous = 0;
+    for (std::size_t i = 0; i < sorted_vertices.size(); ++i) {
+        auto gap = sorted_vertices[i] - previous;
+        previous = sorted_vertices[i];
+
+        auto code = GetLengthCode(gap);
+        control[i / 4] |= code << (2 * (i % 4));
+        std::memcpy(data, &gap, std::size_t{1} << code);
+        data += std::size_t{1} << code;
+    }
+}
+
+}  // namespace
+
+CompressedGraph::CompressedGraph(const IGraph& graph, ReverseEdges reverse_edges)
+    : CompressedGraph(graph.VerticesCount(), [&graph] {
+          std::vector<Edge> edges;
+          for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
+              graph.ForEachNextVertex(from, [&edges, from](std::uint64_t to) {
+                  edges.emplace_back(from, to);
+              });
+          }
+          return edges;
+      }(), reverse_edges) {
+}
+
+CompressedGraph::CompressedGraph(std::size_t size, std::span<const Edge> edges, ReverseEdges reverse_edges,
+                                 std::size_t threads_count)
+    : next_lists_(Encode(GroupBySource(size, edges, threads_count), threads_count)) {
+    if (reverse_edges == ReverseEdges::KEEP) {
+        prev_lists_ = Encode(GroupByTarget(size, edges, threads_count), threads_count);
+    }
+}
+
+void CompressedGraph::AddEdge(std::uint64_t, std::uint64_t) {
+    throw std::logic_error("graph::CompressedGraph can not be modified");
+}
+
+[[nodiscard]] std::size_t CompressedGraph::VerticesCount() const {
+    return next_lists_.offsets.size() - 1;
+}
+
+[[nodiscard]] bool CompressedGraph::KeepsReverseEdges() const {
+    return !prev_lists_.offsets.empty();
+}
+
+[[nodiscard]] std::vector<std::uint64_t> CompressedGraph::GetNextVertices(std::uint64_t vertex) const {
+    std::vector<std::uint64_t> next_vertices;
+    ForEachNextVertex(vertex, [&next_vertices](std::uint64_t to) {
+        next_vertices.push_back(to);
+    });
+
+    return next_vertices;
+}
+
+[[nodiscard]] std::vector<std::uint64_t> CompressedGraph::GetPrevVertices(std::uint64_t vertex) const {
+    std::vector<std::uint64_t> prev_vertices;
+    ForEachPrevVertex(vertex, [&prev_vertices](std::uint64_t from) {
+        prev_vertices.push_back(from);
+    });
+
+    return prev_vertices;
+}
+
+void CompressedGraph::ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachNextVertex<VertexVisitor&>(vertex, visitor);
+}
+
+void CompressedGraph::ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachPrevVertex<VertexVisitor&>(vertex, visitor);
+}
+
+[[nodiscard]] std::size_t CompressedGraph::EncodedBytes() const {
+    return (next_lists_.offsets.size() + prev_lists_.offsets.size()) * sizeof(std::uint64_t)
+           + next_lists_.data.size() + prev_lists_.data.size();
+}
+
+CompressedGraph::EncodedLists CompressedGraph::Encode(AdjacencyArrays&& arrays, std::size_t threads_count) {
+    auto vertices_count = arrays.offsets.size() - 1;
+    auto list = [&arrays](std::size_t vertex) {
+        return std::span<std::uint64_t>(arrays.vertices.data() + arrays.offsets[vertex],
+                                        arrays.vertices.data() + arrays.offsets[vertex + 1]);
+    };
+
+    EncodedLists lists;
+    lists.offsets.assign(vertices_count + 1, 0);
+    ParallelFor(0, vertices_count, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto vertex = begin; vertex < end; ++vertex) {
+            auto vertices = list(vertex);
+            std::sort(vertices.begin(), vertices.end());
+            lists.offsets[vertex + 1] = GetEncodedBytes(vertices);
+        }
+    });
+
+    for (std::size_t vertex = 0; vertex < vertices_count; ++vertex) {
+        lists.offsets[vertex + 1] += lists.offsets[vertex];
+    }
+
+    lists.data.resize(lists.offsets.back() + PADDING);
+    ParallelFor(0, vertices_count, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto vertex = begin; vertex < end; ++vertex) {
+            EncodeBlock(list(vertex), lists.data.data() + lists.offsets[vertex]);
+        }
+    });
+
+    return lists;
+}
+
+}  // namespace graph
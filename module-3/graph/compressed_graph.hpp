@@ -0,0 +1,129 @@
+#pragma once
+
+#include "base.hpp"
+#include "edge_list.hpp"
+#include "parallel.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// read-mostly graph with gap-encoded adjacency lists. every list is sorted and
+// stored as its first vertex followed by the gaps between neighbours, each value
+// taking 1, 2, 4 or 8 bytes. lengths are packed as 2-bit codes into control
+// bytes kept apart from the data (the stream-vbyte layout):
+//
+//   block(v) = varint degree | control [ceil(degree / 4)] | data
+//
+// neighbours are decoded on the fly, so the order of `GetNextVertices` is ascending.
+class CompressedGraph: public IGraph {
+ public:
+    explicit CompressedGraph(const IGraph& graph, ReverseEdges reverse_edges = ReverseEdges::SKIP);
+
+    CompressedGraph(std::size_t size, std::span<const Edge> edges, ReverseEdges reverse_edges = ReverseEdges::SKIP,
+                    std::size_t threads_count = DefaultThreadsCount());
+
+    // throws `std::logic_error`, the encoded lists can not grow.
+    void AddEdge(std::uint64_t from, std::uint64_t to) override;
+
+    [[nodiscard]] std::size_t VerticesCount() const override;
+
+    [[nodiscard]] bool KeepsReverseEdges() const;
+
+    [[nodiscard]] std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const override;
+
+    // O(E) decoding unless built with `ReverseEdges::KEEP`.
+    [[nodiscard]] std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const override;
+
+    void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    template <typename Visitor>
+    void ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    template <typename Visitor>
+    void ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    // memory taken by offsets and encoded lists.
+    [[nodiscard]] std::size_t EncodedBytes() const;
+
+ private:
+    struct EncodedLists {
+        std::vector<std::uint64_t> offsets;
+        std::vector<std::uint8_t> data;
+    };
+
+    static EncodedLists Encode(AdjacencyArrays&& arrays, std::size_t threads_count);
+
+    template <typename Visitor>
+    static void Decode(const EncodedLists& lists, std::uint64_t vertex, Visitor& visitor);
+
+    EncodedLists next_lists_;
+    // empty unless built with `ReverseEdges::KEEP`.
+    EncodedLists prev_lists_;
+};
+
+template <typename Visitor>
+void CompressedGraph::ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+    Decode(next_lists_, vertex, visitor);
+}
+
+template <typename Visitor>
+void CompressedGraph::ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+
+    if (!prev_lists_.offsets.empty()) {
+        Decode(prev_lists_, vertex, visitor);
+        return;
+    }
+
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        auto filter = [&visitor, from, vertex](std::uint64_t to) {
+            if (to == vertex) {
+                visitor(from);
+            }
+        };
+        Decode(next_lists_, from, filter);
+    }
+}
+
+template <typename Visitor>
+void CompressedGraph::Decode(const EncodedLists& lists, std::uint64_t vertex, Visitor& visitor) {
+    const auto* input = lists.data.data() + lists.offsets[vertex];
+
+    std::uint64_t degree = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        auto byte = *input++;
+        degree |= std::uint64_t{byte & 0x7Fu} << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+
+    const auto* control = input;
+    const auto* data = input + (degree + 3) / 4;
+
+    std::uint64_t value = 0;
+    for (std::uint64_t i = 0; i < degree; ++i) {
+        auto code = (control[i / 4] >> (2 * (i % 4))) & 3;
+
+        std::uint64_t gap;
+        std::memcpy(&gap, data, sizeof(gap));
+        if (code != 3) {
+            gap &= (std::uint64_t{1} << (8 << code)) - 1;
+        }
+        data += std::size_t{1} << code;
+
+        value += gap;
+        visitor(value);
+    }
+}
+
+}  // namespace graph
@@ -0,0 +1,411 @@
+#include "contraction_hierarchy.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+
+namespace graph {
+
+namespace {
+
+// a witness search settling more vertices gives up, and the shortcut is added just in case.
+// priorities only estimate the shortcuts, so their searches are cut much earlier.
+constexpr std::size_t CONTRACTION_SETTLED_LIMIT = 500;
+constexpr std::size_t PRIORITY_SETTLED_LIMIT = 50;
+
+struct Arc {
+    std::uint32_t vertex;
+    std::uint64_t weight;
+};
+
+// the graph of vertices not contracted yet, out- and in-arcs of every vertex.
+struct RemainingGraph {
+    std::vector<std::vector<Arc>> next;
+    std::vector<std::vector<Arc>> prev;
+};
+
+// adding `arc` or lowering the weight of the one to the same vertex.
+void AddArc(std::vector<Arc>& arcs, Arc arc) {
+    for (auto& other: arcs) {
+        if (other.vertex == arc.vertex) {
+            other.weight = std::min(other.weight, arc.weight);
+            return;
+        }
+    }
+    arcs.push_back(arc);
+}
+
+void RemoveArc(std::vector<Arc>& arcs, std::uint32_t vertex) {
+    std::erase_if(arcs, [vertex](const Arc& arc) {
+        return arc.vertex == vertex;
+    });
+}
+
+// bounded dijkstra over the remaining graph avoiding excluded vertices, stopping once all
+// targets are settled. the distances of touched vertices are reset by the next search, so a
+// search costs only what it explores.
+class WitnessSearch {
+ public:
+    explicit WitnessSearch(std::size_t size): distances_(size, UNREACHABLE), targets_(size, 0), queue_(size) {
+    }
+
+    // distances from `source` to `targets` avoiding `skipped`, exact up to `limit`.
+    void Run(const RemainingGraph& graph, const std::vector<std::uint8_t>& excluded, std::uint32_t skipped,
+             std::uint32_t source, std::span<const Arc> targets, std::uint64_t limit, std::size_t settled_limit) {
+        for (const auto& vertex: touched_) {
+            distances_[vertex] = UNREACHABLE;
+        }
+        touched_.clear();
+        queue_.Clear();
+
+        ++stamp_;
+        std::size_t targets_left = 0;
+        for (const auto& target: targets) {
+            if (target.vertex != source && targets_[target.vertex] != stamp_) {
+                targets_[target.vertex] = stamp_;
+                ++targets_left;
+            }
+        }
+
+        Reach(source, 0);
+        for (std::size_t settled = 0; !queue_.Empty() && settled < settled_limit; ++settled) {
+            auto [distance, vertex] = queue_.Pop();
+            if (distance > limit || (targets_[vertex] == stamp_ && --targets_left == 0)) {
+                break;
+            }
+            for (const auto& [next, weight]: graph.next[vertex]) {
+                if (next != skipped && !excluded[next] && distance + weight < distances_[next]) {
+                    Reach(next, distance + weight);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t Distance(std::uint32_t vertex) const {
+        return distances_[vertex];
+    }
+
+ private:
+    void Reach(std::uint32_t vertex, std::uint64_t distance) {
+        if (distances_[vertex] == UNREACHABLE) {
+            touched_.push_back(vertex);
+        }
+        distances_[vertex] = distance;
+        queue_.Push(vertex, distance);
+    }
+
+    std::vector<std::uint64_t> distances_;
+    std::vector<std::uint32_t> touched_;
+    // targets of the current search are marked with its stamp.
+    std::vector<std::uint32_t> targets_;
+    std::uint32_t stamp_ = 0;
+    IndexedHeap<4> queue_;
+};
+
+// shortcuts needed to contract `vertex`, i.e. for every path `u -> vertex -> x` without a
+// witness as short. witnesses avoid `vertex` and the vertices marked in `excluded`.
+void FindShortcuts(const RemainingGraph& graph, const std::vector<std::uint8_t>& excluded, std::uint32_t vertex,
+                   WitnessSearch& witness, std::vector<ContractionHierarchy::Edge>& shortcuts, std::size_t settled_limit) {
+    shortcuts.clear();
+    const auto& targets = graph.next[vertex];
+    for (const auto& [from, from_weight]: graph.prev[vertex]) {
+        std::uint64_t limit = 0;
+        bool has_targets = false;
+        for (const auto& [to, to_weight]: targets) {
+            if (to != from) {
+                limit = std::max(limit, from_weight + to_weight);
+                has_targets = true;
+            }
+        }
+        if (!has_targets) {
+            continue;
+        }
+
+        witness.Run(graph, excluded, vertex, from, targets, limit, settled_limit);
+        for (const auto& [to, to_weight]: targets) {
+            if (to != from && witness.Distance(to) > from_weight + to_weight) {
+                shortcuts.push_back({from, to, from_weight + to_weight});
+            }
+        }
+    }
+}
+
+template <typename T>
+void WriteArray(std::ofstream& output, const std::vector<T>& values) {
+    output.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+}  // namespace
+
+ContractionHierarchy::ContractionHierarchy(std::size_t size, std::span<const Edge> edges, std::size_t threads_count) {
+    assert(size <= std::size_t{std::numeric_limits<std::uint32_t>::max()});
+    threads_count = std::max<std::size_t>(threads_count, 1);
+
+    RemainingGraph graph{std::vector<std::vector<Arc>>(size), std::vector<std::vector<Arc>>(size)};
+    for (const auto& [from, to, weight]: edges) {
+        assert(from < size && to < size);
+        if (from != to) {
+            graph.next[from].push_back({to, weight});
+            graph.prev[to].push_back({from, weight});
+        }
+    }
+    // parallel edges are merged by sorting rather than by `AddArc`, hubs would make it quadratic.
+    ParallelFor(0, size, threads_count, [&graph](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto vertex = begin; vertex < end; ++vertex) {
+            for (auto* arcs: {&graph.next[vertex], &graph.prev[vertex]}) {
+                std::sort(arcs->begin(), arcs->end(), [](const Arc& lhs, const Arc& rhs) {
+                    return std::pair(lhs.vertex, lhs.weight) < std::pair(rhs.vertex, rhs.weight);
+                });
+                arcs->erase(std::unique(arcs->begin(), arcs->end(), [](const Arc& lhs, const Arc& rhs) {
+                    return lhs.vertex == rhs.vertex;
+                }), arcs->end());
+            }
+        }
+    });
+
+    std::vector<WitnessSearch> witnesses(threads_count, WitnessSearch(size));
+    std::vector<std::vector<Edge>> thread_shortcuts(threads_count);
+    // the batch being contracted, the rest of the time all zeros.
+    std::vector<std::uint8_t> excluded(size, 0);
+    std::vector<std::uint8_t> contracted(size, 0);
+    std::vector<std::int64_t> priorities(size, 0);
+    // the edge difference is weighted above the terms spreading contraction evenly: neighbours
+    // contracted already and the level, one above the highest contracted neighbour.
+    std::vector<std::int64_t> contracted_neighbours(size, 0);
+    std::vector<std::int64_t> levels(size, 0);
+    auto update_priorities = [&](std::span<const std::uint32_t> vertices) {
+        ParallelFor(0, vertices.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                auto vertex = vertices[i];
+                FindShortcuts(graph, excluded, vertex, witnesses[thread], thread_shortcuts[thread],
+                              PRIORITY_SETTLED_LIMIT);
+
+                auto edge_difference = static_cast<std::int64_t>(thread_shortcuts[thread].size())
+                                       - static_cast<std::int64_t>(graph.next[vertex].size() + graph.prev[vertex].size());
+                priorities[vertex] = 4 * edge_difference + contracted_neighbours[vertex] + levels[vertex];
+            }
+        }, 64);
+    };
+
+    std::vector<std::uint32_t> remaining(size);
+    for (std::size_t vertex = 0; vertex < size; ++vertex) {
+        remaining[vertex] = static_cast<std::uint32_t>(vertex);
+    }
+    update_priorities(remaining);
+
+    ranks_.assign(size, 0);
+    std::uint32_t next_rank = 0;
+    std::vector<Edge> up_edges, down_edges;
+    std::vector<std::uint8_t> selected;
+    std::vector<std::uint32_t> batch, neighbours;
+    std::vector<std::vector<Edge>> batch_shortcuts;
+    while (!remaining.empty()) {
+        // vertices preceding all their neighbours in (priority, id) order, an independent set.
+        auto precedes = [&priorities](std::uint32_t lhs, std::uint32_t rhs) {
+            return std::pair(priorities[lhs], lhs) < std::pair(priorities[rhs], rhs);
+        };
+        selected.assign(remaining.size(), 0);
+        ParallelFor(0, remaining.size(), threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                auto vertex = remaining[i];
+                auto is_minimum = [&](const std::vector<Arc>& arcs) {
+                    return std::all_of(arcs.begin(), arcs.end(), [&](const Arc& arc) {
+                        return precedes(vertex, arc.vertex);
+                    });
+                };
+                selected[i] = is_minimum(graph.next[vertex]) && is_minimum(graph.prev[vertex]);
+            }
+        });
+
+        batch.clear();
+        for (std::size_t i = 0; i < remaining.size(); ++i) {
+            if (selected[i]) {
+                batch.push_back(remaining[i]);
+                excluded[remaining[i]] = 1;
+            }
+        }
+
+        // the batch is contracted at once: a witness path through another vertex of the batch
+        // would disappear together with it, so witness searches avoid the whole batch.
+        batch_shortcuts.resize(batch.size());
+        ParallelFor(0, batch.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                FindShortcuts(graph, excluded, batch[i], witnesses[thread], batch_shortcuts[i],
+                              CONTRACTION_SETTLED_LIMIT);
+            }
+        }, 64);
+
+        neighbours.clear();
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            auto vertex = batch[i];
+            ranks_[vertex] = next_rank++;
+            for (const auto& [to, weight]: graph.next[vertex]) {
+                up_edges.push_back({vertex, to, weight});
+                RemoveArc(graph.prev[to], vertex);
+                ++contracted_neighbours[to];
+                levels[to] = std::max(levels[to], levels[vertex] + 1);
+                neighbours.push_back(to);
+            }
+            for (const auto& [from, weight]: graph.prev[vertex]) {
+                down_edges.push_back({from, vertex, weight});
+                RemoveArc(graph.next[from], vertex);
+                ++contracted_neighbours[from];
+                levels[from] = std::max(levels[from], levels[vertex] + 1);
+                neighbours.push_back(from);
+            }
+            std::vector<Arc>().swap(graph.next[vertex]);
+            std::vector<Arc>().swap(graph.prev[vertex]);
+        }
+        for (const auto& shortcuts: batch_shortcuts) {
+            for (const auto& [from, to, weight]: shortcuts) {
+                AddArc(graph.next[from], {to, weight});
+                AddArc(graph.prev[to], {from, weight});
+            }
+            shortcuts_count_ += shortcuts.size();
+        }
+        for (const auto& vertex: batch) {
+            excluded[vertex] = 0;
+            contracted[vertex] = 1;
+        }
+
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        update_priorities(neighbours);
+
+        std::erase_if(remaining, [&contracted](std::uint32_t vertex) {
+            return contracted[vertex];
+        });
+    }
+
+    for (auto* edges_by_rank: {&up_edges, &down_edges}) {
+        for (auto& edge: *edges_by_rank) {
+            edge = {ranks_[edge.from], ranks_[edge.to], edge.weight};
+        }
+    }
+    up_ = GroupBySource<std::uint32_t, std::uint64_t>(size, up_edges, threads_count);
+    down_ = GroupByTarget<std::uint32_t, std::uint64_t>(size, down_edges, threads_count);
+}
+
+ContractionHierarchy::ContractionHierarchy(const std::filesystem::path& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::system_error(errno, std::generic_category(), "can not open " + path.string());
+    }
+
+    auto read = [&input, &path]<typename T>(std::vector<T>& values, std::uint64_t size) {
+        values.resize(size);
+        if (!input.read(reinterpret_cast<char*>(values.data()), size * sizeof(T))) {
+            throw std::runtime_error(path.string() + " is truncated");
+        }
+    };
+
+    std::vector<std::uint64_t> header;
+    read(header, 6);
+    if (header[0] != MAGIC || header[1] != VERSION) {
+        throw std::runtime_error(path.string() + " is not a contraction hierarchy of version "
+                                 + std::to_string(VERSION));
+    }
+
+    auto [vertices_count, shortcuts_count, up_count, down_count] = std::tuple(header[2], header[3], header[4],
+                                                                              header[5]);
+    auto expected_size = header.size() * sizeof(std::uint64_t) + vertices_count * sizeof(std::uint32_t)
+                         + 2 * (vertices_count + 1) * sizeof(std::uint64_t)
+                         + (up_count + down_count) * (sizeof(std::uint32_t) + sizeof(std::uint64_t));
+    auto file_size = std::filesystem::file_size(path);
+    if (std::max({vertices_count, up_count, down_count}) > file_size || expected_size != file_size) {
+        throw std::runtime_error(path.string() + " is truncated or corrupted");
+    }
+
+    shortcuts_count_ = shortcuts_count;
+    read(ranks_, vertices_count);
+    for (auto [arrays, count]: {std::pair{&up_, up_count}, std::pair{&down_, down_count}}) {
+        read(arrays->offsets, vertices_count + 1);
+        read(arrays->vertices, count);
+        read(arrays->weights, count);
+        if (arrays->offsets.front() != 0 || arrays->offsets.back() != count
+            || !std::is_sorted(arrays->offsets.begin(), arrays->offsets.end())
+            || std::any_of(arrays->vertices.begin(), arrays->vertices.end(), [&](std::uint32_t vertex) {
+                   return vertex >= vertices_count;
+               })) {
+            throw std::runtime_error(path.string() + " is truncated or corrupted");
+        }
+    }
+    if (std::any_of(ranks_.begin(), ranks_.end(), [&](std::uint32_t rank) { return rank >= vertices_count; })) {
+        throw std::runtime_error(path.string() + " is truncated or corrupted");
+    }
+}
+
+void ContractionHierarchy::Save(const std::filesystem::path& path) const {
+    std::ofstream output(path, std::ios::binary);
+    if (!output) {
+        throw std::system_error(errno, std::generic_category(), "can not open " + path.string());
+    }
+
+    WriteArray(output, std::vector<std::uint64_t>{MAGIC, VERSION, VerticesCount(), shortcuts_count_,
+                                                  up_.vertices.size(), down_.vertices.size()});
+    WriteArray(output, ranks_);
+    for (const auto* arrays: {&up_, &down_}) {
+        WriteArray(output, arrays->offsets);
+        WriteArray(output, arrays->vertices);
+        WriteArray(output, arrays->weights);
+    }
+
+    output.close();
+    if (!output) {
+        throw std::runtime_error("failed to write contraction hierarchy to " + path.string());
+    }
+}
+
+[[nodiscard]] std::size_t ContractionHierarchy::VerticesCount() const {
+    return ranks_.size();
+}
+
+[[nodiscard]] std::size_t ContractionHierarchy::EdgesCount() const {
+    return up_.vertices.size() + down_.vertices.size();
+}
+
+[[nodiscard]] std::size_t ContractionHierarchy::ShortcutsCount() const {
+    return shortcuts_count_;
+}
+
+[[nodiscard]] std::uint32_t ContractionHierarchy::GetRank(std::uint64_t vertex) const {
+    assert(vertex < ranks_.size());
+    return ranks_[vertex];
+}
+
+[[nodiscard]] std::uint64_t ContractionHierarchy::Distance(std::uint64_t from, std::uint64_t to) const {
+    return ContractionHierarchyQuery(*this).Distance(from, to);
+}
+
+ContractionHierarchyQuery::ContractionHierarchyQuery(const ContractionHierarchy& hierarchy)
+    : hierarchy_(hierarchy),
+      forward_{std::vector<std::uint64_t>(hierarchy.VerticesCount(), UNREACHABLE), {},
+               IndexedHeap<4>(hierarchy.VerticesCount())},
+      backward_{std::vector<std::uint64_t>(hierarchy.VerticesCount(), UNREACHABLE), {},
+                IndexedHeap<4>(hierarchy.VerticesCount())} {
+}
+
+void ContractionHierarchyQuery::Reset(Search& search) {
+    for (const auto& rank: search.touched) {
+        search.distances[rank] = UNREACHABLE;
+    }
+    search.touched.clear();
+    search.queue.Clear();
+}
+
+void ContractionHierarchyQuery::Reach(Search& search, std::uint32_t rank, std::uint64_t distance) {
+    if (search.distances[rank] == UNREACHABLE) {
+        search.touched.push_back(rank);
+    }
+    search.distances[rank] = distance;
+    search.queue.Push(rank, distance);
+}
+
+}  // namespace graph
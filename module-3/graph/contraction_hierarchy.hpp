@@ -0,0 +1,217 @@
+#pragma once
+
+#include "base.hpp"
+#include "edge_list.hpp"
+#include "heaps.hpp"
+#include "parallel.hpp"
+#include "traversal.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// contraction hierarchy: vertices are contracted one by one in the order of importance,
+// and a shortcut `u -> x` replaces a path `u -> v -> x` through the contracted `v` unless
+// a witness search finds a path as short avoiding `v`. the rank of a vertex is its position
+// in that order, and every shortest path has a shortest "up then down" counterpart in the
+// original graph plus the shortcuts. a query then only searches upwards from both ends and
+// settles hundreds of vertices instead of a ball of the whole radius.
+//
+// the order is picked greedily by edge difference (shortcuts added minus edges removed)
+// plus the number of contracted neighbours, which spreads contraction evenly. vertices that
+// are local minima of that priority form an independent set, which is contracted in parallel.
+//
+// inside the hierarchy vertices are numbered by rank: the upward search moves to larger ids,
+// and the top of the hierarchy, where both searches of every query meet, is stored compactly.
+class ContractionHierarchy {
+ public:
+    static constexpr std::uint64_t MAGIC = 0x0048'5041'5247'4843;  // "CHGRAPH\0" on little-endian
+    static constexpr std::uint32_t VERSION = 1;
+
+    using Edge = BasicWeightedEdge<std::uint32_t, std::uint64_t>;
+
+    // contraction of `graph`, parallel edges keep the lightest weight and loops are dropped.
+    // every thread keeps O(V) witness search state.
+    ContractionHierarchy(std::size_t size, std::span<const Edge> edges,
+                         std::size_t threads_count = DefaultThreadsCount());
+
+    template <WeightedAdjacencyGraph Graph>
+    explicit ContractionHierarchy(const Graph& graph, std::size_t threads_count = DefaultThreadsCount());
+
+    // loading the hierarchy saved by `Save`.
+    explicit ContractionHierarchy(const std::filesystem::path& path);
+
+    // file layout: magic, version, vertices, shortcuts, upward and downward edges counts
+    // (all uint64), then ranks and the upward and downward arrays (offsets, vertices, weights).
+    void Save(const std::filesystem::path& path) const;
+
+    [[nodiscard]] std::size_t VerticesCount() const;
+
+    // edges of both directions, original ones and shortcuts.
+    [[nodiscard]] std::size_t EdgesCount() const;
+
+    [[nodiscard]] std::size_t ShortcutsCount() const;
+
+    // id of `vertex` inside the hierarchy.
+    [[nodiscard]] std::uint32_t GetRank(std::uint64_t vertex) const;
+
+    // calls `visitor(to, weight)` for every edge from `rank` to a higher ranked vertex.
+    template <typename Visitor>
+    void ForEachUpwardEdge(std::uint32_t rank, Visitor&& visitor) const;
+
+    // calls `visitor(from, weight)` for every edge into `rank` from a higher ranked vertex.
+    template <typename Visitor>
+    void ForEachDownwardEdge(std::uint32_t rank, Visitor&& visitor) const;
+
+    // one query with scratch state allocated for it, see `ContractionHierarchyQuery` to repeat queries.
+    [[nodiscard]] std::uint64_t Distance(std::uint64_t from, std::uint64_t to) const;
+
+ private:
+    using Arrays = BasicAdjacencyArrays<std::uint32_t, std::uint64_t>;
+
+    template <typename Visitor>
+    static void ForEachEdge(const Arrays& arrays, std::uint32_t rank, Visitor& visitor);
+
+    std::vector<std::uint32_t> ranks_;
+    // upward edges grouped by source, downward ones grouped by target.
+    Arrays up_;
+    Arrays down_;
+    std::size_t shortcuts_count_ = 0;
+};
+
+// scratch state of hierarchy queries. only the entries touched by a query are reset by the
+// next one, so a query costs as much as the vertices it settles. one object per thread.
+class ContractionHierarchyQuery {
+ public:
+    explicit ContractionHierarchyQuery(const ContractionHierarchy& hierarchy);
+
+    // bidirectional upward dijkstra with stall-on-demand: a vertex reached more cheaply from
+    // above than by its own distance is not on a shortest up-down path and is not expanded.
+    // `visitor.DiscoverVertex` gets the ranks of settled vertices.
+    template <typename Visitor = TraversalVisitor>
+    std::uint64_t Distance(std::uint64_t from, std::uint64_t to, Visitor&& visitor = {});
+
+ private:
+    struct Search {
+        std::vector<std::uint64_t> distances;
+        std::vector<std::uint32_t> touched;
+        IndexedHeap<4> queue;
+    };
+
+    static void Reset(Search& search);
+
+    static void Reach(Search& search, std::uint32_t rank, std::uint64_t distance);
+
+    const ContractionHierarchy& hierarchy_;
+    Search forward_;
+    Search backward_;
+};
+
+template <WeightedAdjacencyGraph Graph>
+ContractionHierarchy::ContractionHierarchy(const Graph& graph, std::size_t threads_count)
+    : ContractionHierarchy(graph.VerticesCount(), [&graph] {
+          using vertex_t = typename Graph::vertex_t;
+          using weight_t = typename Graph::weight_t;
+          assert(graph.VerticesCount() <= std::size_t{std::numeric_limits<std::uint32_t>::max()});
+
+          std::vector<Edge> edges;
+          for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
+              graph.ForEachNextEdge(static_cast<vertex_t>(from), [&edges, from](vertex_t to, weight_t weight) {
+                  edges.push_back(Edge{static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to), weight});
+              });
+          }
+          return edges;
+      }(), threads_count) {
+}
+
+template <typename Visitor>
+void ContractionHierarchy::ForEachUpwardEdge(std::uint32_t rank, Visitor&& visitor) const {
+    ForEachEdge(up_, rank, visitor);
+}
+
+template <typename Visitor>
+void ContractionHierarchy::ForEachDownwardEdge(std::uint32_t rank, Visitor&& visitor) const {
+    ForEachEdge(down_, rank, visitor);
+}
+
+template <typename Visitor>
+void ContractionHierarchy::ForEachEdge(const Arrays& arrays, std::uint32_t rank, Visitor& visitor) {
+    assert(rank + std::size_t{1} < arrays.offsets.size());
+    for (auto i = arrays.offsets[rank]; i < arrays.offsets[rank + 1]; ++i) {
+        visitor(arrays.vertices[i], arrays.weights[i]);
+    }
+}
+
+template <typename Visitor>
+std::uint64_t ContractionHierarchyQuery::Distance(std::uint64_t from, std::uint64_t to, Visitor&& visitor) {
+    Reset(forward_);
+    Reset(backward_);
+
+    auto source = hierarchy_.GetRank(from);
+    auto target = hierarchy_.GetRank(to);
+    if (source == target) {
+        return 0;
+    }
+    Reach(forward_, source, 0);
+    Reach(backward_, target, 0);
+
+    auto best = UNREACHABLE;
+    while (true) {
+        // the side with the smaller key goes next, both stop once their keys reach `best`.
+        auto forward_key = forward_.queue.Empty() ? UNREACHABLE : forward_.queue.Top().first;
+        auto backward_key = backward_.queue.Empty() ? UNREACHABLE : backward_.queue.Top().first;
+        if (std::min(forward_key, backward_key) >= best) {
+            break;
+        }
+
+        auto is_forward = forward_key <= backward_key;
+        auto& search = is_forward ? forward_ : backward_;
+        const auto& other = is_forward ? backward_ : forward_;
+
+        auto [distance, rank] = search.queue.Pop();
+        auto vertex = static_cast<std::uint32_t>(rank);
+        visitor.DiscoverVertex(vertex);
+        if (other.distances[vertex] != UNREACHABLE) {
+            best = std::min(best, distance + other.distances[vertex]);
+        }
+
+        bool stalled = false;
+        auto stall = [&](std::uint32_t higher, std::uint64_t weight) {
+            if (search.distances[higher] != UNREACHABLE && search.distances[higher] + weight < distance) {
+                stalled = true;
+            }
+        };
+        auto relax = [&](std::uint32_t next, std::uint64_t weight) {
+            visitor.ExamineEdge(vertex, next);
+            if (distance + weight < search.distances[next]) {
+                visitor.TreeEdge(vertex, next);
+                Reach(search, next, distance + weight);
+            }
+        };
+
+        // the edges into `vertex` from above are scanned by the opposite direction of the search.
+        if (is_forward) {
+            hierarchy_.ForEachDownwardEdge(vertex, stall);
+            if (!stalled) {
+                hierarchy_.ForEachUpwardEdge(vertex, relax);
+            }
+        } else {
+            hierarchy_.ForEachUpwardEdge(vertex, stall);
+            if (!stalled) {
+                hierarchy_.ForEachDownwardEdge(vertex, relax);
+            }
+        }
+        visitor.FinishVertex(vertex);
+    }
+
+    return best;
+}
+
+}  // namespace graph
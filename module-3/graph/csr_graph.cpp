@@ -0,0 +1,117 @@
+#include "csr_graph.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+
+namespace graph {
+
+CsrGraph::CsrGraph(std::size_t size): next_offsets_(size + 1, 0), prev_offsets_(size + 1, 0) {
+}
+
+CsrGraph::CsrGraph(const IGraph& graph): next_offsets_(graph.VerticesCount() + 1, 0) {
+    for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
+        next_offsets_[from + 1] = next_offsets_[from];
+        graph.ForEachNextVertex(from, [this, from](std::uint64_t) {
+            ++next_offsets_[from + 1];
+        });
+    }
+
+    next_vertices_.resize(next_offsets_.back());
+    for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
+        auto cursor = next_offsets_[from];
+        graph.ForEachNextVertex(from, [this, &cursor](std::uint64_t to) {
+            next_vertices_[cursor++] = to;
+        });
+    }
+
+    BuildPrevIndex();
+}
+
+CsrGraph::CsrGraph(std::size_t size, std::span<const Edge> edges, std::size_t threads_count)
+    : CsrGraph(GroupBySource(size, edges, threads_count), GroupByTarget(size, edges, threads_count)) {
+}
+
+CsrGraph::CsrGraph(AdjacencyArrays&& next, AdjacencyArrays&& prev)
+    : next_offsets_(std::move(next.offsets)),
+      next_vertices_(std::move(next.vertices)),
+      prev_offsets_(std::move(prev.offsets)),
+      prev_vertices_(std::move(prev.vertices)) {
+}
+
+void CsrGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
+    assert(from < VerticesCount());
+    assert(to < VerticesCount());
+
+    next_vertices_.insert(next_vertices_.begin() + next_offsets_[from + 1], to);
+    for (std::size_t vertex = from + 1; vertex < next_offsets_.size(); ++vertex) {
+        ++next_offsets_[vertex];
+    }
+
+    prev_vertices_.insert(prev_vertices_.begin() + prev_offsets_[to + 1], from);
+    for (std::size_t vertex = to + 1; vertex < prev_offsets_.size(); ++vertex) {
+        ++prev_offsets_[vertex];
+    }
+}
+
+[[nodiscard]] std::size_t CsrGraph::VerticesCount() const {
+    return next_offsets_.size() - 1;
+}
+
+[[nodiscard]] std::size_t CsrGraph::EdgesCount() const {
+    return next_vertices_.size();
+}
+
+[[nodiscard]] std::vector<std::uint64_t> CsrGraph::GetNextVertices(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return {next_vertices_.begin() + next_offsets_[vertex],
+            next_vertices_.begin() + next_offsets_[vertex + 1]};
+}
+
+[[nodiscard]] std::vector<std::uint64_t> CsrGraph::GetPrevVertices(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return {prev_vertices_.begin() + prev_offsets_[vertex],
+            prev_vertices_.begin() + prev_offsets_[vertex + 1]};
+}
+
+// counting sort of the forward arrays by target vertex.
+void CsrGraph::BuildPrevIndex() {
+    prev_offsets_.assign(next_offsets_.size(), 0);
+    prev_vertices_.resize(next_vertices_.size());
+
+    for (const auto& to: next_vertices_) {
+        ++prev_offsets_[to + 1];
+    }
+
+    for (std::size_t vertex = 0; vertex < VerticesCount(); ++vertex) {
+        prev_offsets_[vertex + 1] += prev_offsets_[vertex];
+    }
+
+    std::vector<std::uint64_t> cursor(prev_offsets_.begin(), prev_offsets_.end() - 1);
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        for (auto i = next_offsets_[from]; i < next_offsets_[from + 1]; ++i) {
+            prev_vertices_[cursor[next_vertices_[i]]++] = from;
+        }
+    }
+}
+
+void CsrGraph::ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachNextVertex<VertexVisitor&>(vertex, visitor);
+}
+
+void CsrGraph::ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachPrevVertex<VertexVisitor&>(vertex, visitor);
+}
+
+[[nodiscard]] std::span<const std::uint64_t> CsrGraph::GetNextVerticesView(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return {next_vertices_.data() + next_offsets_[vertex], next_vertices_.data() + next_offsets_[vertex + 1]};
+}
+
+[[nodiscard]] std::span<const std::uint64_t> CsrGraph::GetPrevVerticesView(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return {prev_vertices_.data() + prev_offsets_[vertex], prev_vertices_.data() + prev_offsets_[vertex + 1]};
+}
+
+}  // namespace graph
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "base.hpp"
+#include "edge_list.hpp"
+#include "parallel.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// compressed sparse row graph: successors and predecessors of every vertex
+// are stored in two contiguous arrays indexed by per-vertex offsets.
+class CsrGraph: public IGraph {
+ public:
+    using Edge = graph::Edge;
+
+    explicit CsrGraph(std::size_t size);
+
+    explicit CsrGraph(const IGraph& graph);
+
+    // built in parallel, see `GroupBySource`.
+    CsrGraph(std::size_t size, std::span<const Edge> edges, std::size_t threads_count = DefaultThreadsCount());
+
+    // O(V + E): shifts the arrays, prefer building from an edge list.
+    void AddEdge(std::uint64_t from, std::uint64_t to) override;
+
+    [[nodiscard]] std::size_t VerticesCount() const override;
+
+    [[nodiscard]] std::size_t EdgesCount() const;
+
+    [[nodiscard]] std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const override;
+
+    [[nodiscard]] std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const override;
+
+    void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    template <typename Visitor>
+    void ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    template <typename Visitor>
+    void ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    // views into the underlying arrays, valid until the next `AddEdge`.
+    [[nodiscard]] std::span<const std::uint64_t> GetNextVerticesView(std::uint64_t vertex) const;
+
+    [[nodiscard]] std::span<const std::uint64_t> GetPrevVerticesView(std::uint64_t vertex) const;
+
+ private:
+    CsrGraph(AdjacencyArrays&& next, AdjacencyArrays&& prev);
+
+    void BuildPrevIndex();
+
+    std::vector<std::uint64_t> next_offsets_;
+    std::vector<std::uint64_t> next_vertices_;
+    std::vector<std::uint64_t> prev_offsets_;
+    std::vector<std::uint64_t> prev_vertices_;
+};
+
+template <typename Visitor>
+void CsrGraph::ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+    for (auto i = next_offsets_[vertex]; i < next_offsets_[vertex + 1]; ++i) {
+        visitor(next_vertices_[i]);
+    }
+}
+
+template <typename Visitor>
+void CsrGraph::ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+    for (auto i = prev_offsets_[vertex]; i < prev_offsets_[vertex + 1]; ++i) {
+        visitor(prev_vertices_[i]);
+    }
+}
+
+}  // namespace graph
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "base.hpp"
+#include "parallel.hpp"
+#include "traversal.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+
+namespace graph {
+
+namespace detail {
+
+// lowering `value` to `candidate`, true if it was larger.
+inline bool AtomicMin(std::uint64_t& value, std::uint64_t candidate) {
+    std::atomic_ref<std::uint64_t> atomic(value);
+    auto current = atomic.load(std::memory_order_relaxed);
+    while (candidate < current) {
+        if (atomic.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace detail
+
+// parallel single source shortest paths by delta-stepping (Meyer and Sanders). tentative
+// distances are kept in buckets of width `delta` and the lowest bucket is emptied in phases:
+// light edges (weight <= `delta`) of its vertices are relaxed in parallel, possibly refilling
+// the bucket, and once it stays empty the heavy edges of everything it held are relaxed once.
+// small `delta` approaches dijkstra (little wasted work, many phases), large `delta` approaches
+// bellman-ford (few phases, vertices relaxed many times); the average edge weight is a good
+// start. returns the same distances as `Dijkstra`.
+//
+// all tentative distances are within the largest weight of the current bucket, so only
+// `max_weight / delta + 2` buckets are allocated and used cyclically.
+template <WeightedAdjacencyGraph Graph>
+std::vector<std::uint64_t> DeltaStepping(const Graph& graph, std::uint64_t source, std::uint64_t delta,
+                                         std::size_t threads_count = DefaultThreadsCount()) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+    assert(source < graph.VerticesCount());
+    assert(delta > 0);
+    threads_count = std::max<std::size_t>(threads_count, 1);
+
+    auto vertices_count = graph.VerticesCount();
+    std::vector<std::uint64_t> max_weights(threads_count, 0);
+    ParallelFor(0, vertices_count, threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        for (auto vertex = begin; vertex < end; ++vertex) {
+            graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t, weight_t weight) {
+                max_weights[thread] = std::max<std::uint64_t>(max_weights[thread], weight);
+            });
+        }
+    });
+    auto max_weight = *std::max_element(max_weights.begin(), max_weights.end());
+
+    std::vector<std::uint64_t> distances(vertices_count, UNREACHABLE);
+    std::vector<std::vector<std::uint64_t>> buckets(max_weight / delta + 2);
+    // a vertex is put into the next frontier once per phase, stamped with the phase number.
+    std::vector<std::uint64_t> stamps(vertices_count, 0);
+    std::uint64_t phase = 0;
+    // the bucket a vertex was last settled in, so that heavy edges are relaxed once per bucket.
+    std::vector<std::uint64_t> settled_in(vertices_count, UNREACHABLE);
+    // vertices whose distance dropped during a phase, per thread.
+    std::vector<std::vector<std::uint64_t>> improved(threads_count);
+
+    auto relax = [&](const std::vector<std::uint64_t>& vertices, bool light) {
+        ParallelFor(0, vertices.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                auto vertex = vertices[i];
+                auto distance = std::atomic_ref<std::uint64_t>(distances[vertex]).load(std::memory_order_relaxed);
+                graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t to, weight_t weight) {
+                    if ((weight <= delta) == light && detail::AtomicMin(distances[to], distance + weight)) {
+                        improved[thread].push_back(to);
+                    }
+                });
+            }
+        }, 256);
+
+        ++phase;
+        for (auto& vertices_improved: improved) {
+            for (const auto& vertex: vertices_improved) {
+                auto index = distances[vertex] / delta;
+                if (stamps[vertex] != phase) {
+                    stamps[vertex] = phase;
+                    buckets[index % buckets.size()].push_back(vertex);
+                }
+            }
+            vertices_improved.clear();
+        }
+    };
+
+    distances[source] = 0;
+    buckets[0].push_back(source);
+    std::vector<std::uint64_t> frontier, settled;
+    for (std::uint64_t index = 0;; ++index) {
+        // the next bucket holding a vertex, none of them within the window means all are settled.
+        std::size_t skipped = 0;
+        while (skipped < buckets.size() && buckets[index % buckets.size()].empty()) {
+            ++index;
+            ++skipped;
+        }
+        if (skipped == buckets.size()) {
+            break;
+        }
+
+        settled.clear();
+        auto& bucket = buckets[index % buckets.size()];
+        while (!bucket.empty()) {
+            // entries left behind by a later improvement belong to a lower, already emptied bucket.
+            frontier.clear();
+            for (const auto& vertex: bucket) {
+                if (distances[vertex] / delta == index) {
+                    frontier.push_back(vertex);
+                }
+            }
+            bucket.clear();
+
+            for (const auto& vertex: frontier) {
+                if (settled_in[vertex] != index) {
+                    settled_in[vertex] = index;
+                    settled.push_back(vertex);
+                }
+            }
+            relax(frontier, true);
+        }
+        relax(settled, false);
+    }
+
+    return distances;
+}
+
+}  // namespace graph
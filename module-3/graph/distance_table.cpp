@@ -0,0 +1,143 @@
+#include "distance_table.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+
+namespace graph {
+
+namespace {
+
+// upward search in a contraction hierarchy with stall-on-demand, reusing its state between
+// runs. forward searches go up along upward edges, backward ones along downward edges.
+class UpwardSearch {
+ public:
+    explicit UpwardSearch(std::size_t size): distances_(size, UNREACHABLE), queue_(size) {
+    }
+
+    // calls `visit(rank, distance)` for every settled vertex that is not stalled.
+    template <typename Visit>
+    void Run(const ContractionHierarchy& hierarchy, std::uint32_t source, bool forward, Visit&& visit) {
+        for (const auto& rank: touched_) {
+            distances_[rank] = UNREACHABLE;
+        }
+        touched_.clear();
+        queue_.Clear();
+
+        Reach(source, 0);
+        while (!queue_.Empty()) {
+            auto [distance, rank] = queue_.Pop();
+            auto vertex = static_cast<std::uint32_t>(rank);
+
+            bool stalled = false;
+            auto stall = [&](std::uint32_t higher, std::uint64_t weight) {
+                if (distances_[higher] != UNREACHABLE && distances_[higher] + weight < distance) {
+                    stalled = true;
+                }
+            };
+            auto relax = [&](std::uint32_t next, std::uint64_t weight) {
+                if (distance + weight < distances_[next]) {
+                    Reach(next, distance + weight);
+                }
+            };
+
+            if (forward) {
+                hierarchy.ForEachDownwardEdge(vertex, stall);
+            } else {
+                hierarchy.ForEachUpwardEdge(vertex, stall);
+            }
+            if (stalled) {
+                continue;
+            }
+
+            visit(vertex, distance);
+            if (forward) {
+                hierarchy.ForEachUpwardEdge(vertex, relax);
+            } else {
+                hierarchy.ForEachDownwardEdge(vertex, relax);
+            }
+        }
+    }
+
+ private:
+    void Reach(std::uint32_t rank, std::uint64_t distance) {
+        if (distances_[rank] == UNREACHABLE) {
+            touched_.push_back(rank);
+        }
+        distances_[rank] = distance;
+        queue_.Push(rank, distance);
+    }
+
+    std::vector<std::uint64_t> distances_;
+    std::vector<std::uint32_t> touched_;
+    IndexedHeap<4> queue_;
+};
+
+}  // namespace
+
+[[nodiscard]] std::vector<std::uint64_t> DistanceTable(const ContractionHierarchy& hierarchy,
+                                                       std::span<const std::uint64_t> sources,
+                                                       std::span<const std::uint64_t> targets,
+                                                       std::size_t threads_count) {
+    using Entry = BasicWeightedEdge<std::uint32_t, std::uint64_t>;
+    assert(targets.size() <= std::size_t{std::numeric_limits<std::uint32_t>::max()});
+
+    threads_count = std::clamp<std::size_t>(threads_count, 1, std::max({sources.size(), targets.size(),
+                                                                        std::size_t{1}}));
+    std::vector<UpwardSearch> searches(threads_count, UpwardSearch(hierarchy.VerticesCount()));
+
+    // bucket entries `(rank, target index, distance)` collected per thread, then grouped by rank.
+    std::vector<std::vector<Entry>> thread_entries(threads_count);
+    ParallelFor(0, targets.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        for (auto j = begin; j < end; ++j) {
+            searches[thread].Run(hierarchy, hierarchy.GetRank(targets[j]), false,
+                                 [&](std::uint32_t rank, std::uint64_t distance) {
+                thread_entries[thread].push_back({rank, static_cast<std::uint32_t>(j), distance});
+            });
+        }
+    }, 1);
+
+    // buckets grouped by rank with a counting sort: `offsets` into parallel target and distance arrays.
+    std::vector<std::size_t> offsets(hierarchy.VerticesCount() + 1, 0);
+    for (const auto& part: thread_entries) {
+        for (const auto& entry: part) {
+            ++offsets[entry.from + 1];
+        }
+    }
+    for (std::size_t rank = 0; rank < hierarchy.VerticesCount(); ++rank) {
+        offsets[rank + 1] += offsets[rank];
+    }
+    std::vector<std::uint32_t> bucket_targets(offsets.back());
+    std::vector<std::uint64_t> bucket_distances(offsets.back());
+    {
+        auto positions = offsets;
+        for (auto& part: thread_entries) {
+            for (const auto& entry: part) {
+                auto position = positions[entry.from]++;
+                bucket_targets[position] = entry.to;
+                bucket_distances[position] = entry.weight;
+            }
+            std::vector<Entry>().swap(part);
+        }
+    }
+
+    std::vector<std::uint64_t> table(sources.size() * targets.size(), UNREACHABLE);
+    ParallelFor(0, sources.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto* row = table.data() + i * targets.size();
+            searches[thread].Run(hierarchy, hierarchy.GetRank(sources[i]), true,
+                                 [&](std::uint32_t rank, std::uint64_t distance) {
+                for (auto k = offsets[rank]; k < offsets[rank + 1]; ++k) {
+                    auto& cell = row[bucket_targets[k]];
+                    cell = std::min(cell, distance + bucket_distances[k]);
+                }
+            });
+        }
+    }, 1);
+
+    return table;
+}
+
+}  // namespace graph
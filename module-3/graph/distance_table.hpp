@@ -0,0 +1,100 @@
+#pragma once
+
+#include "base.hpp"
+#include "contraction_hierarchy.hpp"
+#include "heaps.hpp"
+#include "parallel.hpp"
+#include "traversal.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// many-to-many distances: `table[i * targets.size() + j]` is the distance from `sources[i]`
+// to `targets[j]` (`UNREACHABLE` if there is no path).
+//
+// one dijkstra per source, stopped once every target is settled. sources are spread over
+// the threads, and every thread reuses its distances and heap between sources, resetting
+// only the entries the previous search touched.
+template <WeightedAdjacencyGraph Graph>
+std::vector<std::uint64_t> DistanceTable(const Graph& graph, std::span<const std::uint64_t> sources,
+                                         std::span<const std::uint64_t> targets,
+                                         std::size_t threads_count = DefaultThreadsCount()) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+
+    std::vector<std::uint8_t> is_target(graph.VerticesCount(), 0);
+    std::size_t distinct_targets = 0;
+    for (const auto& target: targets) {
+        assert(target < graph.VerticesCount());
+        distinct_targets += is_target[target] == 0;
+        is_target[target] = 1;
+    }
+
+    struct Scratch {
+        std::vector<std::uint64_t> distances;
+        std::vector<std::uint64_t> touched;
+        IndexedHeap<4> queue;
+    };
+    threads_count = std::clamp<std::size_t>(threads_count, 1, std::max<std::size_t>(sources.size(), 1));
+    std::vector<Scratch> scratches(threads_count, Scratch{std::vector<std::uint64_t>(graph.VerticesCount(), UNREACHABLE),
+                                                          {}, IndexedHeap<4>(graph.VerticesCount())});
+
+    std::vector<std::uint64_t> table(sources.size() * targets.size(), UNREACHABLE);
+    ParallelFor(0, sources.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        auto& [distances, touched, queue] = scratches[thread];
+        for (auto i = begin; i < end; ++i) {
+            assert(sources[i] < graph.VerticesCount());
+            for (const auto& vertex: touched) {
+                distances[vertex] = UNREACHABLE;
+            }
+            touched.clear();
+            queue.Clear();
+
+            auto reach = [&](std::uint64_t vertex, std::uint64_t distance) {
+                if (distances[vertex] == UNREACHABLE) {
+                    touched.push_back(vertex);
+                }
+                distances[vertex] = distance;
+                queue.Push(vertex, distance);
+            };
+
+            reach(sources[i], 0);
+            auto targets_left = distinct_targets;
+            while (!queue.Empty()) {
+                auto [distance, vertex] = queue.Pop();
+                targets_left -= is_target[vertex];
+                if (targets_left == 0) {
+                    break;
+                }
+                graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t next, weight_t weight) {
+                    if (distance + weight < distances[next]) {
+                        reach(next, distance + weight);
+                    }
+                });
+            }
+
+            for (std::size_t j = 0; j < targets.size(); ++j) {
+                table[i * targets.size() + j] = distances[targets[j]];
+            }
+        }
+    }, 1);
+
+    return table;
+}
+
+// the same on a contraction hierarchy with buckets (Knopp et al.): an upward backward search
+// from every target leaves `(target, distance)` in the bucket of each vertex it settles, then
+// an upward forward search from every source combines its distances with the buckets it
+// meets. that is S + T small searches instead of S * T queries, both phases run in parallel.
+[[nodiscard]] std::vector<std::uint64_t> DistanceTable(const ContractionHierarchy& hierarchy,
+                                                       std::span<const std::uint64_t> sources,
+                                                       std::span<const std::uint64_t> targets,
+                                                       std::size_t threads_count = DefaultThreadsCount());
+
+}  // namespace graph
@@ -0,0 +1,200 @@
+#include "dynamic_shortest_paths.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+
+namespace graph {
+
+DynamicShortestPaths::DynamicShortestPaths(std::size_t size, std::span<const Edge> edges, std::uint64_t source)
+    : source_(static_cast<std::uint32_t>(source)), next_(size), prev_(size), distances_(size, UNREACHABLE),
+      parents_(size, NO_PARENT), queue_(size), affected_(size, 0) {
+    assert(size <= std::size_t{std::numeric_limits<std::uint32_t>::max()});
+    assert(source < size);
+
+    for (const auto& edge: edges) {
+        assert(edge.from < size && edge.to < size);
+        if (edge.from == edge.to) {
+            continue;
+        }
+
+        auto i = Find(next_, edge.from, edge.to);
+        if (i < next_[edge.from].size()) {
+            auto& weight = next_[edge.from][i].second;
+            weight = std::min(weight, edge.weight);
+            prev_[edge.to][Find(prev_, edge.to, edge.from)].second = weight;
+        } else {
+            next_[edge.from].emplace_back(edge.to, edge.weight);
+            prev_[edge.to].emplace_back(edge.from, edge.weight);
+        }
+    }
+
+    Decrease(source_, 0, source_);
+}
+
+[[nodiscard]] std::size_t DynamicShortestPaths::VerticesCount() const {
+    return distances_.size();
+}
+
+[[nodiscard]] std::uint64_t DynamicShortestPaths::GetSource() const {
+    return source_;
+}
+
+[[nodiscard]] std::uint64_t DynamicShortestPaths::GetDistance(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return distances_[vertex];
+}
+
+[[nodiscard]] std::uint32_t DynamicShortestPaths::GetParent(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return parents_[vertex];
+}
+
+[[nodiscard]] std::uint64_t DynamicShortestPaths::GetWeight(std::uint64_t from, std::uint64_t to) const {
+    assert(from < VerticesCount() && to < VerticesCount());
+    auto i = Find(next_, static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to));
+    return i < next_[from].size() ? next_[from][i].second : UNREACHABLE;
+}
+
+std::span<const std::uint32_t> DynamicShortestPaths::SetEdge(std::uint64_t from, std::uint64_t to,
+                                                             std::uint64_t weight) {
+    assert(from < VerticesCount() && to < VerticesCount());
+    assert(weight != UNREACHABLE);
+    changed_.clear();
+    if (from == to) {
+        return changed_;
+    }
+
+    auto tail = static_cast<std::uint32_t>(from);
+    auto head = static_cast<std::uint32_t>(to);
+    auto i = Find(next_, tail, head);
+    auto old_weight = UNREACHABLE;
+    if (i < next_[tail].size()) {
+        old_weight = next_[tail][i].second;
+        next_[tail][i].second = weight;
+        prev_[head][Find(prev_, head, tail)].second = weight;
+    } else {
+        next_[tail].emplace_back(head, weight);
+        prev_[head].emplace_back(tail, weight);
+    }
+
+    if (weight < old_weight) {
+        if (distances_[tail] != UNREACHABLE) {
+            Decrease(head, distances_[tail] + weight, tail);
+        }
+    } else if (weight > old_weight && parents_[head] == tail) {
+        Increase(head);
+    }
+    return changed_;
+}
+
+std::span<const std::uint32_t> DynamicShortestPaths::RemoveEdge(std::uint64_t from, std::uint64_t to) {
+    assert(from < VerticesCount() && to < VerticesCount());
+    changed_.clear();
+
+    auto tail = static_cast<std::uint32_t>(from);
+    auto head = static_cast<std::uint32_t>(to);
+    auto i = Find(next_, tail, head);
+    if (i == next_[tail].size()) {
+        return changed_;
+    }
+
+    // the lists are unordered, the last edge takes the place of the removed one.
+    next_[tail][i] = next_[tail].back();
+    next_[tail].pop_back();
+    auto j = Find(prev_, head, tail);
+    prev_[head][j] = prev_[head].back();
+    prev_[head].pop_back();
+
+    if (parents_[head] == tail) {
+        Increase(head);
+    }
+    return changed_;
+}
+
+std::size_t DynamicShortestPaths::Find(const Adjacency& lists, std::uint32_t from, std::uint32_t to) {
+    const auto& list = lists[from];
+    std::size_t i = 0;
+    while (i < list.size() && list[i].first != to) {
+        ++i;
+    }
+    return i;
+}
+
+void DynamicShortestPaths::Decrease(std::uint32_t vertex, std::uint64_t distance, std::uint32_t parent) {
+    if (distance >= distances_[vertex]) {
+        return;
+    }
+
+    distances_[vertex] = distance;
+    parents_[vertex] = parent;
+    queue_.Push(vertex, distance);
+    Propagate();
+}
+
+void DynamicShortestPaths::Increase(std::uint32_t vertex) {
+    assert(vertex != source_);
+
+    // the subtree of `vertex`, collected through the children of every collected vertex.
+    region_.clear();
+    region_.emplace_back(vertex, distances_[vertex]);
+    affected_[vertex] = 1;
+    for (std::size_t head = 0; head < region_.size(); ++head) {
+        auto parent = region_[head].first;
+        for (const auto& [child, weight]: next_[parent]) {
+            if (parents_[child] == parent && affected_[child] == 0) {
+                affected_[child] = 1;
+                region_.emplace_back(child, distances_[child]);
+            }
+        }
+    }
+
+    for (const auto& [affected, distance]: region_) {
+        distances_[affected] = UNREACHABLE;
+        parents_[affected] = NO_PARENT;
+    }
+    // distances outside the region stay exact, the best edge from there seeds every affected vertex.
+    for (const auto& [affected, distance]: region_) {
+        for (const auto& [from, weight]: prev_[affected]) {
+            if (affected_[from] == 0 && distances_[from] != UNREACHABLE
+                && distances_[from] + weight < distances_[affected]) {
+                distances_[affected] = distances_[from] + weight;
+                parents_[affected] = from;
+            }
+        }
+        if (distances_[affected] != UNREACHABLE) {
+            queue_.Push(affected, distances_[affected]);
+        }
+    }
+    Propagate();
+
+    changed_.clear();
+    for (const auto& [affected, distance]: region_) {
+        affected_[affected] = 0;
+        if (distances_[affected] != distance) {
+            changed_.push_back(affected);
+        }
+    }
+}
+
+void DynamicShortestPaths::Propagate() {
+    while (!queue_.Empty()) {
+        auto [distance, vertex] = queue_.Pop();
+        // only `Decrease` runs dijkstra outside a region, and then every vertex it settles has changed.
+        if (affected_[vertex] == 0) {
+            changed_.push_back(static_cast<std::uint32_t>(vertex));
+        }
+
+        for (const auto& [to, weight]: next_[vertex]) {
+            if (distance + weight < distances_[to]) {
+                distances_[to] = distance + weight;
+                parents_[to] = static_cast<std::uint32_t>(vertex);
+                queue_.Push(to, distances_[to]);
+            }
+        }
+    }
+}
+
+}  // namespace graph
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "base.hpp"
+#include "edge_list.hpp"
+#include "heaps.hpp"
+#include "traversal.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace graph {
+
+// shortest path tree from a fixed source kept up to date under edge updates (Ramalingam and
+// Reps). the structure owns its graph, with at most one edge per ordered pair of vertices.
+//
+// an edge getting cheaper (inserted or decreased) can only lower distances, and a dijkstra
+// seeded at its target repairs exactly the vertices it improves. an edge getting dearer
+// (removed or increased) matters only if it is a tree edge: then the subtree below it is the
+// affected region. its vertices are seeded with the best edge from the unaffected rest and a
+// dijkstra restricted to them recomputes their distances. in both cases the work is bounded
+// by the affected vertices and their edges, not by the graph.
+class DynamicShortestPaths {
+ public:
+    using Edge = BasicWeightedEdge<std::uint32_t, std::uint64_t>;
+
+    // parent of the vertices not reachable from the source.
+    static constexpr std::uint32_t NO_PARENT = std::numeric_limits<std::uint32_t>::max();
+
+    // parallel edges keep the lightest weight and loops are dropped, as they never lie on a shortest path.
+    DynamicShortestPaths(std::size_t size, std::span<const Edge> edges, std::uint64_t source);
+
+    template <WeightedAdjacencyGraph Graph>
+    DynamicShortestPaths(const Graph& graph, std::uint64_t source);
+
+    [[nodiscard]] std::size_t VerticesCount() const;
+
+    [[nodiscard]] std::uint64_t GetSource() const;
+
+    // `UNREACHABLE` if there is no path.
+    [[nodiscard]] std::uint64_t GetDistance(std::uint64_t vertex) const;
+
+    // the previous vertex on the shortest path, the source is its own parent.
+    [[nodiscard]] std::uint32_t GetParent(std::uint64_t vertex) const;
+
+    // `UNREACHABLE` if there is no such edge.
+    [[nodiscard]] std::uint64_t GetWeight(std::uint64_t from, std::uint64_t to) const;
+
+    // inserting `from -> to` or changing its weight. the result lists the vertices whose
+    // distances changed and is valid until the next update.
+    std::span<const std::uint32_t> SetEdge(std::uint64_t from, std::uint64_t to, std::uint64_t weight);
+
+    // the same for removing `from -> to`, nothing changes if there is no such edge.
+    std::span<const std::uint32_t> RemoveEdge(std::uint64_t from, std::uint64_t to);
+
+ private:
+    using Adjacency = std::vector<std::vector<std::pair<std::uint32_t, std::uint64_t>>>;
+
+    // position of `to` in `lists[from]`, the list size if it is absent.
+    static std::size_t Find(const Adjacency& lists, std::uint32_t from, std::uint32_t to);
+
+    // `vertex` got a path of `distance` through `parent`, spreading the improvement.
+    void Decrease(std::uint32_t vertex, std::uint64_t distance, std::uint32_t parent);
+
+    // the tree edge into `vertex` became dearer or vanished, recomputing its subtree.
+    void Increase(std::uint32_t vertex);
+
+    // dijkstra from the vertices already in the queue.
+    void Propagate();
+
+    std::uint32_t source_;
+    // out-edges as `(to, weight)` and in-edges as `(from, weight)`.
+    Adjacency next_;
+    Adjacency prev_;
+    std::vector<std::uint64_t> distances_;
+    std::vector<std::uint32_t> parents_;
+
+    // scratch state of updates, kept between them.
+    IndexedHeap<4> queue_;
+    std::vector<std::uint8_t> affected_;
+    // affected vertices with their distances before the update.
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> region_;
+    std::vector<std::uint32_t> changed_;
+};
+
+template <WeightedAdjacencyGraph Graph>
+DynamicShortestPaths::DynamicShortestPaths(const Graph& graph, std::uint64_t source)
+    : DynamicShortestPaths(graph.VerticesCount(), [&graph] {
+          using vertex_t = typename Graph::vertex_t;
+          using weight_t = typename Graph::weight_t;
+          assert(graph.VerticesCount() <= std::size_t{std::numeric_limits<std::uint32_t>::max()});
+
+          std::vector<Edge> edges;
+          for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
+              graph.ForEachNextEdge(static_cast<vertex_t>(from), [&edges, from](vertex_t to, weight_t weight) {
+                  edges.push_back(Edge{static_cast<std::uint32_t>(from), static_cast<std::uint32_t>(to), weight});
+              });
+          }
+          return edges;
+      }(), source) {
+}
+
+}  // namespace graph
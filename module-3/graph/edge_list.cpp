@@ -0,0 +1,57 @@
+#include "edge_list.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+
+namespace graph {
+
+void PrefixSum(std::vector<std::uint64_t>& values, std::size_t threads_count) {
+    auto size = values.size() - 1;
+    auto chunk = std::max<std::size_t>((size + threads_count - 1) / threads_count, 1);
+    std::vector<std::uint64_t> chunk_sums((size + chunk - 1) / chunk + 1, 0);
+
+    ParallelFor(0, size, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::uint64_t sum = 0;
+        for (auto i = begin; i < end; ++i) {
+            sum += values[i];
+        }
+        chunk_sums[begin / chunk + 1] = sum;
+    }, chunk);
+
+    for (std::size_t i = 1; i < chunk_sums.size(); ++i) {
+        chunk_sums[i] += chunk_sums[i - 1];
+    }
+
+    ParallelFor(0, size, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+        auto sum = chunk_sums[begin / chunk];
+        for (auto i = begin; i < end; ++i) {
+            sum += std::exchange(values[i], sum);
+        }
+    }, chunk);
+
+    values[size] = chunk_sums.back();
+}
+
+[[nodiscard]] AdjacencyArrays GroupBySource(std::size_t vertices_count, std::span<const Edge> edges,
+                                            std::size_t threads_count) {
+    return GroupEdges<std::uint64_t, std::uint64_t>(vertices_count, edges, threads_count,
+                                                    [](const Edge& edge) { return edge.first; },
+                                                    [](const Edge& edge) { return edge.second; },
+                                                    [](const Edge&) { return std::uint64_t{0}; },
+                                                    false);
+}
+
+[[nodiscard]] AdjacencyArrays GroupByTarget(std::size_t vertices_count, std::span<const Edge> edges,
+                                            std::size_t threads_count) {
+    return GroupEdges<std::uint64_t, std::uint64_t>(vertices_count, edges, threads_count,
+                                                    [](const Edge& edge) { return edge.second; },
+                                                    [](const Edge& edge) { return edge.first; },
+                                                    [](const Edge&) { return std::uint64_t{0}; },
+                                                    false);
+}
+
+}  // namespace graph
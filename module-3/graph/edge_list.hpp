@@ -0,0 +1,120 @@
+#pragma once
+
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace graph {
+
+using Edge = std::pair<std::uint64_t, std::uint64_t>;
+
+template <typename Vertex, typename Weight>
+struct BasicWeightedEdge {
+    Vertex from;
+    Vertex to;
+    Weight weight;
+};
+
+using WeightedEdge = BasicWeightedEdge<std::uint64_t, std::uint64_t>;
+
+// edges grouped by one of their endpoints: the edges of vertex `v` are
+// [offsets[v], offsets[v + 1]) in `vertices` (and `weights` for weighted edges).
+// vertices and weights are stored in separate arrays of their own width.
+template <typename Vertex, typename Weight = std::uint64_t>
+struct BasicAdjacencyArrays {
+    std::vector<std::uint64_t> offsets;
+    std::vector<Vertex> vertices;
+    std::vector<Weight> weights;
+};
+
+using AdjacencyArrays = BasicAdjacencyArrays<std::uint64_t>;
+
+// exclusive prefix sum of `values[0, size - 1)` written in place, the last value
+// becomes the total. every thread scans one contiguous chunk twice.
+void PrefixSum(std::vector<std::uint64_t>& values, std::size_t threads_count = DefaultThreadsCount());
+
+// bulk grouping of an edge list by `key(edge)`: degrees are counted in parallel,
+// turned into offsets by a parallel prefix sum, and edges are scattered in parallel
+// into arrays allocated once. the order of edges inside a group is unspecified for
+// more than one thread.
+template <typename Vertex, typename Weight, typename EdgeType, typename Key, typename Other, typename WeightOf>
+[[nodiscard]] BasicAdjacencyArrays<Vertex, Weight> GroupEdges(std::size_t vertices_count,
+                                                              std::span<const EdgeType> edges,
+                                                              std::size_t threads_count,
+                                                              Key key, Other other, WeightOf weight, bool weighted) {
+    threads_count = std::max<std::size_t>(threads_count, 1);
+
+    BasicAdjacencyArrays<Vertex, Weight> arrays;
+    arrays.offsets.assign(vertices_count + 1, 0);
+    ParallelFor(0, edges.size(), threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            assert(key(edges[i]) < vertices_count);
+            assert(other(edges[i]) < vertices_count);
+            std::atomic_ref<std::uint64_t>(arrays.offsets[key(edges[i])]).fetch_add(1, std::memory_order_relaxed);
+        }
+    }, 1 << 16);
+
+    PrefixSum(arrays.offsets, threads_count);
+
+    arrays.vertices.resize(edges.size());
+    if (weighted) {
+        arrays.weights.resize(edges.size());
+    }
+
+    std::vector<std::uint64_t> cursor(arrays.offsets.begin(), arrays.offsets.end() - 1);
+    ParallelFor(0, edges.size(), threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto position = std::atomic_ref<std::uint64_t>(cursor[key(edges[i])]).fetch_add(1, std::memory_order_relaxed);
+            arrays.vertices[position] = other(edges[i]);
+            if (weighted) {
+                arrays.weights[position] = weight(edges[i]);
+            }
+        }
+    }, 1 << 16);
+
+    return arrays;
+}
+
+[[nodiscard]] AdjacencyArrays GroupBySource(std::size_t vertices_count, std::span<const Edge> edges,
+                                            std::size_t threads_count = DefaultThreadsCount());
+
+// same, grouping by target with `vertices` holding sources.
+[[nodiscard]] AdjacencyArrays GroupByTarget(std::size_t vertices_count, std::span<const Edge> edges,
+                                            std::size_t threads_count = DefaultThreadsCount());
+
+template <typename Vertex, typename Weight>
+[[nodiscard]] BasicAdjacencyArrays<Vertex, Weight> GroupBySource(
+    std::size_t vertices_count,
+    std::span<const BasicWeightedEdge<Vertex, Weight>> edges,
+    std::size_t threads_count = DefaultThreadsCount()
+) {
+    using EdgeType = BasicWeightedEdge<Vertex, Weight>;
+    return GroupEdges<Vertex, Weight>(vertices_count, edges, threads_count,
+                                      [](const EdgeType& edge) { return edge.from; },
+                                      [](const EdgeType& edge) { return edge.to; },
+                                      [](const EdgeType& edge) { return edge.weight; },
+                                      true);
+}
+
+template <typename Vertex, typename Weight>
+[[nodiscard]] BasicAdjacencyArrays<Vertex, Weight> GroupByTarget(
+    std::size_t vertices_count,
+    std::span<const BasicWeightedEdge<Vertex, Weight>> edges,
+    std::size_t threads_count = DefaultThreadsCount()
+) {
+    using EdgeType = BasicWeightedEdge<Vertex, Weight>;
+    return GroupEdges<Vertex, Weight>(vertices_count, edges, threads_count,
+                                      [](const EdgeType& edge) { return edge.to; },
+                                      [](const EdgeType& edge) { return edge.from; },
+                                      [](const EdgeType& edge) { return edge.weight; },
+                                      true);
+}
+
+}  // namespace graph
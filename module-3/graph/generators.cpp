@@ -0,0 +1,149 @@
+#include "generators.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+
+
+namespace graph {
+
+namespace {
+
+constexpr std::uint64_t GRID_STEP = 100;
+constexpr std::uint64_t MAX_JITTER = 30;
+
+// the distributions of <random> are implementation-defined, these helpers are not.
+std::uint64_t GetUniform(std::mt19937_64& random, std::uint64_t bound) {
+    return random() % bound;
+}
+
+double GetProbability(std::mt19937_64& random) {
+    return static_cast<double>(random() >> 11) * 0x1.0p-53;
+}
+
+}  // namespace
+
+[[nodiscard]] std::vector<Edge> ErdosRenyiEdges(std::size_t vertices_count, std::size_t edges_count,
+                                                std::uint64_t seed) {
+    assert(vertices_count > 0);
+
+    std::mt19937_64 random(seed);
+    std::vector<Edge> edges(edges_count);
+    for (auto& [from, to]: edges) {
+        from = GetUniform(random, vertices_count);
+        to = GetUniform(random, vertices_count);
+    }
+
+    return edges;
+}
+
+[[nodiscard]] std::vector<Edge> RmatEdges(std::size_t scale, std::size_t edges_count, std::uint64_t seed,
+                                          RmatParameters parameters) {
+    assert(scale < 64);
+    assert(parameters.a + parameters.b + parameters.c <= 1);
+
+    std::mt19937_64 random(seed);
+    std::vector<Edge> edges(edges_count);
+    for (auto& [from, to]: edges) {
+        from = 0;
+        to = 0;
+        for (std::size_t level = 0; level < scale; ++level) {
+            auto probability = GetProbability(random);
+            auto bottom = probability >= parameters.a + parameters.b;
+            auto right = (probability >= parameters.a && probability < parameters.a + parameters.b)
+                         || probability >= parameters.a + parameters.b + parameters.c;
+            from = from << 1 | std::uint64_t{bottom};
+            to = to << 1 | std::uint64_t{right};
+        }
+    }
+
+    return edges;
+}
+
+[[nodiscard]] std::vector<Edge> GridEdges(std::size_t rows, std::size_t columns) {
+    std::vector<Edge> edges;
+    edges.reserve(4 * rows * columns);
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t column = 0; column < columns; ++column) {
+            auto vertex = row * columns + column;
+            if (column + 1 < columns) {
+                edges.emplace_back(vertex, vertex + 1);
+                edges.emplace_back(vertex + 1, vertex);
+            }
+            if (row + 1 < rows) {
+                edges.emplace_back(vertex, vertex + columns);
+                edges.emplace_back(vertex + columns, vertex);
+            }
+        }
+    }
+
+    return edges;
+}
+
+[[nodiscard]] std::vector<WeightedEdge> RoadEdges(std::size_t rows, std::size_t columns, std::uint64_t seed) {
+    std::mt19937_64 random(seed);
+
+    std::vector<std::pair<double, double>> positions(rows * columns);
+    for (std::size_t vertex = 0; vertex < positions.size(); ++vertex) {
+        auto jitter = [&random] {
+            return static_cast<double>(GetUniform(random, 2 * MAX_JITTER + 1)) - static_cast<double>(MAX_JITTER);
+        };
+        positions[vertex] = {static_cast<double>(vertex % columns * GRID_STEP) + jitter(),
+                             static_cast<double>(vertex / columns * GRID_STEP) + jitter()};
+    }
+
+    std::vector<WeightedEdge> edges;
+    auto add_road = [&](std::uint64_t from, std::uint64_t to) {
+        auto length = std::hypot(positions[from].first - positions[to].first,
+                                 positions[from].second - positions[to].second);
+        auto weight = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::llround(length)));
+        edges.push_back({from, to, weight});
+        edges.push_back({to, from, weight});
+    };
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t column = 0; column < columns; ++column) {
+            auto vertex = row * columns + column;
+            if (column + 1 < columns && GetUniform(random, 10) != 0) {
+                add_road(vertex, vertex + 1);
+            }
+            if (row + 1 < rows && GetUniform(random, 10) != 0) {
+                add_road(vertex, vertex + columns);
+            }
+            if (column + 1 < columns && row + 1 < rows && GetUniform(random, 10) == 0) {
+                add_road(vertex, vertex + columns + 1);
+            }
+        }
+    }
+
+    return edges;
+}
+
+[[nodiscard]] std::vector<WeightedEdge> AddRandomWeights(std::span<const Edge> edges, std::uint64_t max_weight,
+                                                         std::uint64_t seed) {
+    assert(max_weight > 0);
+
+    std::mt19937_64 random(seed);
+    std::vector<WeightedEdge> weighted_edges;
+    weighted_edges.reserve(edges.size());
+    for (const auto& [from, to]: edges) {
+        weighted_edges.push_back({from, to, 1 + GetUniform(random, max_weight)});
+    }
+
+    return weighted_edges;
+}
+
+[[nodiscard]] std::vector<Edge> RemoveWeights(std::span<const WeightedEdge> edges) {
+    std::vector<Edge> unweighted_edges;
+    unweighted_edges.reserve(edges.size());
+    for (const auto& edge: edges) {
+        unweighted_edges.emplace_back(edge.from, edge.to);
+    }
+
+    return unweighted_edges;
+}
+
+}  // namespace graph
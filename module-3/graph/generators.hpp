@@ -0,0 +1,47 @@
+#pragma once
+
+#include "edge_list.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// seeded synthetic workloads: the same arguments always give the same edges, on any
+// platform, since values come from the raw output of `std::mt19937_64`.
+
+// G(n, m): `edges_count` arcs with uniformly random ends, repeats and self-loops included.
+[[nodiscard]] std::vector<Edge> ErdosRenyiEdges(std::size_t vertices_count, std::size_t edges_count,
+                                                std::uint64_t seed);
+
+// quadrant probabilities of R-MAT, the bottom-right one is `1 - a - b - c`.
+struct RmatParameters {
+    double a = 0.57;
+    double b = 0.19;
+    double c = 0.19;
+};
+
+// R-MAT over 2^scale vertices: every arc descends `scale` times into a quadrant of the
+// adjacency matrix, which gives a power-law degree distribution with hubs at low ids.
+[[nodiscard]] std::vector<Edge> RmatEdges(std::size_t scale, std::size_t edges_count, std::uint64_t seed,
+                                          RmatParameters parameters = {});
+
+// `rows x columns` grid, vertex `row * columns + column`, both directions of every side.
+[[nodiscard]] std::vector<Edge> GridEdges(std::size_t rows, std::size_t columns);
+
+// road-like planar network on a grid with jittered vertex positions: a tenth of the sides
+// is dropped and a tenth of the cells gets a diagonal (always the same one, so roads never
+// cross). weights are euclidean lengths with the grid step of 100, both directions of
+// every road are listed.
+[[nodiscard]] std::vector<WeightedEdge> RoadEdges(std::size_t rows, std::size_t columns, std::uint64_t seed);
+
+// `edges` with weights uniform in [1, max_weight].
+[[nodiscard]] std::vector<WeightedEdge> AddRandomWeights(std::span<const Edge> edges, std::uint64_t max_weight,
+                                                         std::uint64_t seed);
+
+// the same edges without weights.
+[[nodiscard]] std::vector<Edge> RemoveWeights(std::span<const WeightedEdge> edges);
+
+}  // namespace graph
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+
+namespace graph {
+
+// priority queue of vertices `[0, size)` keyed by tentative distances, as used by `Dijkstra`.
+// `Push` inserts a vertex or lowers its key, `Pop` returns `(key, vertex)` with the minimum key.
+// a queue may return a vertex more than once (with its older keys), callers skip such entries.
+template <typename Queue>
+concept VertexQueue = std::constructible_from<Queue, std::size_t>
+                      && requires(Queue queue, std::uint64_t vertex, std::uint64_t key) {
+    queue.Push(vertex, key);
+    { queue.Pop() } -> std::same_as<std::pair<std::uint64_t, std::uint64_t>>;
+    { queue.Empty() } -> std::convertible_to<bool>;
+};
+
+// binary heap with lazy deletion, as `std::priority_queue`: every decrease pushes one more entry.
+class LazyHeap {
+ public:
+    explicit LazyHeap(std::size_t) {
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return entries_.empty();
+    }
+
+    void Push(std::uint64_t vertex, std::uint64_t key) {
+        entries_.emplace_back(key, vertex);
+        std::push_heap(entries_.begin(), entries_.end(), std::greater<>());
+    }
+
+    std::pair<std::uint64_t, std::uint64_t> Pop() {
+        std::pop_heap(entries_.begin(), entries_.end(), std::greater<>());
+        auto top = entries_.back();
+        entries_.pop_back();
+        return top;
+    }
+
+    // dropping all entries, the memory is kept for the next use.
+    void Clear() {
+        entries_.clear();
+    }
+
+ private:
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> entries_;
+};
+
+// d-ary heap keeping the position of every vertex, so a key is decreased in place and the
+// heap never holds more than one entry per vertex. with 4 children the tree is half as deep
+// as a binary one and the children of a node share a cache line.
+template <std::size_t Arity = 4>
+class IndexedHeap {
+    static_assert(Arity >= 2);
+
+ public:
+    explicit IndexedHeap(std::size_t size): positions_(size, ABSENT) {
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return nodes_.empty();
+    }
+
+    [[nodiscard]] std::size_t Size() const {
+        return nodes_.size();
+    }
+
+    [[nodiscard]] bool Contains(std::uint64_t vertex) const {
+        assert(vertex < positions_.size());
+        return positions_[vertex] != ABSENT;
+    }
+
+    // inserting `vertex` or lowering its key, a key is never increased.
+    void Push(std::uint64_t vertex, std::uint64_t key) {
+        assert(vertex < positions_.size());
+
+        auto position = positions_[vertex];
+        if (position == ABSENT) {
+            position = nodes_.size();
+            nodes_.push_back({key, vertex});
+        } else {
+            assert(key <= nodes_[position].key);
+            nodes_[position].key = key;
+        }
+        SiftUp(position);
+    }
+
+    [[nodiscard]] std::pair<std::uint64_t, std::uint64_t> Top() const {
+        assert(!Empty());
+        return {nodes_.front().key, nodes_.front().vertex};
+    }
+
+    std::pair<std::uint64_t, std::uint64_t> Pop() {
+        auto top = Top();
+        positions_[top.second] = ABSENT;
+
+        auto last = nodes_.back();
+        nodes_.pop_back();
+        if (!nodes_.empty()) {
+            nodes_.front() = last;
+            SiftDown(0);
+        }
+
+        return top;
+    }
+
+    // O(size of the heap), not of the vertices count.
+    void Clear() {
+        for (const auto& node: nodes_) {
+            positions_[node.vertex] = ABSENT;
+        }
+        nodes_.clear();
+    }
+
+ private:
+    static constexpr std::size_t ABSENT = std::numeric_limits<std::size_t>::max();
+
+    struct Node {
+        std::uint64_t key;
+        std::uint64_t vertex;
+    };
+
+    void Place(std::size_t position, const Node& node) {
+        nodes_[position] = node;
+        positions_[node.vertex] = position;
+    }
+
+    void SiftUp(std::size_t position) {
+        auto node = nodes_[position];
+        while (position > 0) {
+            auto parent = (position - 1) / Arity;
+            if (nodes_[parent].key <= node.key) {
+                break;
+            }
+            Place(position, nodes_[parent]);
+            position = parent;
+        }
+        Place(position, node);
+    }
+
+    void SiftDown(std::size_t position) {
+        auto node = nodes_[position];
+        while (true) {
+            auto first_child = position * Arity + 1;
+            if (first_child >= nodes_.size()) {
+                break;
+            }
+
+            auto min_child = first_child;
+            auto last_child = std::min(first_child + Arity, nodes_.size());
+            for (auto child = first_child + 1; child < last_child; ++child) {
+                if (nodes_[child].key < nodes_[min_child].key) {
+                    min_child = child;
+                }
+            }
+
+            if (node.key <= nodes_[min_child].key) {
+                break;
+            }
+            Place(position, nodes_[min_child]);
+            position = min_child;
+        }
+        Place(position, node);
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<std::size_t> positions_;
+};
+
+// monotone radix heap for integer keys: no key pushed may be less than the last popped one.
+// bucket `i` holds keys whose highest bit differing from the last popped key is `i - 1`, so
+// every entry moves to a lower bucket at most 64 times and pops are amortized O(log C).
+// decreases push one more entry, like `LazyHeap`.
+class RadixHeap {
+ public:
+    // the vertices count is not needed, it is accepted to be interchangeable with `IndexedHeap`.
+    explicit RadixHeap(std::size_t) {
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return size_ == 0;
+    }
+
+    void Push(std::uint64_t vertex, std::uint64_t key) {
+        assert(key >= last_);
+        buckets_[GetBucket(key)].push_back({key, vertex});
+        ++size_;
+    }
+
+    std::pair<std::uint64_t, std::uint64_t> Pop() {
+        assert(!Empty());
+
+        if (buckets_[0].empty()) {
+            std::size_t index = 1;
+            while (buckets_[index].empty()) {
+                ++index;
+            }
+
+            auto& bucket = buckets_[index];
+            last_ = std::numeric_limits<std::uint64_t>::max();
+            for (const auto& [key, vertex]: bucket) {
+                last_ = std::min(last_, key);
+            }
+            for (const auto& entry: bucket) {
+                buckets_[GetBucket(entry.first)].push_back(entry);
+            }
+            bucket.clear();
+        }
+
+        auto top = buckets_[0].back();
+        buckets_[0].pop_back();
+        --size_;
+        return top;
+    }
+
+    // dropping all entries, the memory is kept for the next use.
+    void Clear() {
+        for (auto& bucket: buckets_) {
+            bucket.clear();
+        }
+        last_ = 0;
+        size_ = 0;
+    }
+
+ private:
+    [[nodiscard]] std::size_t GetBucket(std::uint64_t key) const {
+        return std::bit_width(key ^ last_);
+    }
+
+    std::array<std::vector<std::pair<std::uint64_t, std::uint64_t>>, 65> buckets_;
+    std::uint64_t last_ = 0;
+    std::size_t size_ = 0;
+};
+
+// dial's bucket queue for small integer weights: a ring of buckets indexed by `key mod size`
+// with the last popped key as the cursor. keys in the queue lie within the largest weight of
+// the cursor, so the ring has `max_weight + 1` buckets rounded up to a power of two and grows
+// the first time a wider edge is pushed. `Pop` scans at most one ring of empty buckets, which
+// gives O(V + E + max_weight * max_distance) in total, and buckets keep their capacity, so
+// pushes stop allocating after warm-up. monotone and with lazy decreases like `RadixHeap`.
+class BucketQueue {
+ public:
+    // the vertices count is not needed, it is accepted to be interchangeable with `IndexedHeap`.
+    explicit BucketQueue(std::size_t): buckets_(1) {
+    }
+
+    [[nodiscard]] bool Empty() const {
+        return size_ == 0;
+    }
+
+    void Push(std::uint64_t vertex, std::uint64_t key) {
+        assert(key >= cursor_);
+        if (key - cursor_ >= buckets_.size()) {
+            Grow(key - cursor_ + 1);
+        }
+        buckets_[key & (buckets_.size() - 1)].push_back(vertex);
+        ++size_;
+    }
+
+    std::pair<std::uint64_t, std::uint64_t> Pop() {
+        assert(!Empty());
+
+        while (buckets_[cursor_ & (buckets_.size() - 1)].empty()) {
+            ++cursor_;
+        }
+        auto& bucket = buckets_[cursor_ & (buckets_.size() - 1)];
+        auto vertex = bucket.back();
+        bucket.pop_back();
+        --size_;
+        return {cursor_, vertex};
+    }
+
+    // dropping all entries, the memory is kept for the next use.
+    void Clear() {
+        for (auto& bucket: buckets_) {
+            bucket.clear();
+        }
+        cursor_ = 0;
+        size_ = 0;
+    }
+
+ private:
+    // a bucket holds the only key of its residue within `[cursor_, cursor_ + size)`.
+    void Grow(std::uint64_t width) {
+        std::vector<std::vector<std::uint64_t>> buckets(std::bit_ceil(width));
+        auto mask = buckets_.size() - 1;
+        for (std::size_t index = 0; index < buckets_.size(); ++index) {
+            auto key = cursor_ + ((index - cursor_) & mask);
+            auto& bucket = buckets[key & (buckets.size() - 1)];
+            bucket.insert(bucket.end(), buckets_[index].begin(), buckets_[index].end());
+        }
+        buckets_ = std::move(buckets);
+    }
+
+    std::vector<std::vector<std::uint64_t>> buckets_;
+    std::uint64_t cursor_ = 0;
+    std::size_t size_ = 0;
+};
+
+}  // namespace graph
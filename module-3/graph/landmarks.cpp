@@ -0,0 +1,98 @@
+#include "landmarks.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+
+namespace graph {
+
+Landmarks::Landmarks(const std::filesystem::path& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::system_error(errno, std::generic_category(), "can not open " + path.string());
+    }
+
+    auto read = [&input, &path](void* data, std::size_t bytes) {
+        if (!input.read(static_cast<char*>(data), bytes)) {
+            throw std::runtime_error(path.string() + " is truncated");
+        }
+    };
+
+    std::uint64_t header[4];
+    read(header, sizeof(header));
+    if (header[0] != MAGIC || header[1] != VERSION) {
+        throw std::runtime_error(path.string() + " is not a landmarks file of version " + std::to_string(VERSION));
+    }
+
+    auto file_size = std::filesystem::file_size(path);
+    vertices_count_ = header[2];
+    auto count = header[3];
+    if (count > vertices_count_ || vertices_count_ > file_size
+        || (sizeof(header) + count * sizeof(std::uint64_t) + 2 * count * vertices_count_ * sizeof(std::uint32_t)
+            != file_size)) {
+        throw std::runtime_error(path.string() + " is truncated or corrupted");
+    }
+
+    landmarks_.resize(count);
+    read(landmarks_.data(), count * sizeof(std::uint64_t));
+    distances_.resize(2 * count * vertices_count_);
+    read(distances_.data(), distances_.size() * sizeof(std::uint32_t));
+}
+
+void Landmarks::Save(const std::filesystem::path& path) const {
+    std::ofstream output(path, std::ios::binary);
+    if (!output) {
+        throw std::system_error(errno, std::generic_category(), "can not open " + path.string());
+    }
+
+    const std::uint64_t header[4] = {MAGIC, VERSION, vertices_count_, landmarks_.size()};
+    output.write(reinterpret_cast<const char*>(header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(landmarks_.data()), landmarks_.size() * sizeof(std::uint64_t));
+    output.write(reinterpret_cast<const char*>(distances_.data()), distances_.size() * sizeof(std::uint32_t));
+
+    output.close();
+    if (!output) {
+        throw std::runtime_error("failed to write landmarks to " + path.string());
+    }
+}
+
+[[nodiscard]] std::size_t Landmarks::VerticesCount() const {
+    return vertices_count_;
+}
+
+[[nodiscard]] std::size_t Landmarks::LandmarksCount() const {
+    return landmarks_.size();
+}
+
+[[nodiscard]] std::span<const std::uint64_t> Landmarks::GetLandmarks() const {
+    return landmarks_;
+}
+
+void Landmarks::Pack(const std::vector<std::vector<std::uint64_t>>& from_landmarks,
+                     const std::vector<std::vector<std::uint64_t>>& to_landmarks) {
+    auto pack = [](std::uint64_t distance) {
+        if (distance == UNREACHABLE) {
+            return INFINITE;
+        }
+        if (distance >= INFINITE) {
+            throw std::overflow_error("graph::Landmarks distance " + std::to_string(distance)
+                                      + " does not fit 32 bits");
+        }
+        return static_cast<std::uint32_t>(distance);
+    };
+
+    auto count = landmarks_.size();
+    distances_.resize(2 * count * vertices_count_);
+    for (std::size_t vertex = 0; vertex < vertices_count_; ++vertex) {
+        for (std::size_t i = 0; i < count; ++i) {
+            distances_[2 * (vertex * count + i)] = pack(from_landmarks[i][vertex]);
+            distances_[2 * (vertex * count + i) + 1] = pack(to_landmarks[i][vertex]);
+        }
+    }
+}
+
+}  // namespace graph
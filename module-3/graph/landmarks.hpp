@@ -0,0 +1,249 @@
+#pragma once
+
+#include "base.hpp"
+#include "heaps.hpp"
+#include "parallel.hpp"
+#include "traversal.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// how `Landmarks` picks its vertices.
+enum class LandmarkSelection {
+    // every next landmark is the vertex farthest from the chosen ones.
+    FARTHEST,
+    // Goldberg and Werneck's "avoid": grow a shortest path tree from a random root, weigh
+    // every vertex by how much the current bounds underestimate its distance, and take the
+    // leaf of the heaviest subtree free of landmarks. it covers poorly bounded regions.
+    AVOID
+};
+
+// ALT preprocessing: exact distances from and to a few landmark vertices. by the triangle
+// inequality `d(s, t) >= d(L, t) - d(L, s)` and `d(s, t) >= d(s, L) - d(t, L)` for every
+// landmark `L`, which gives a consistent A* potential, see `AltDistance`.
+//
+// distances are stored as uint32, vertex-major (the 2k values of a vertex are adjacent),
+// so evaluating a bound reads one or two cache lines per vertex.
+class Landmarks {
+ public:
+    static constexpr std::uint64_t MAGIC = 0x0053'4B52'414D'444C;  // "LDMARKS\0" on little-endian
+    static constexpr std::uint32_t VERSION = 1;
+
+    // `count` Dijkstra runs in each direction (plus one per landmark to grow the tree for
+    // `AVOID`), the two directions run in parallel. throws `std::overflow_error` if a finite
+    // distance does not fit 32 bits.
+    template <BidirectionalWeightedGraph Graph>
+    Landmarks(const Graph& graph, std::size_t count, LandmarkSelection selection = LandmarkSelection::AVOID,
+              std::uint64_t seed = 0, std::size_t threads_count = DefaultThreadsCount());
+
+    // loading the landmarks saved by `Save`.
+    explicit Landmarks(const std::filesystem::path& path);
+
+    // file layout: magic, version, vertices and landmarks counts, landmark ids (all uint64)
+    // followed by the packed distances.
+    void Save(const std::filesystem::path& path) const;
+
+    [[nodiscard]] std::size_t VerticesCount() const;
+
+    [[nodiscard]] std::size_t LandmarksCount() const;
+
+    [[nodiscard]] std::span<const std::uint64_t> GetLandmarks() const;
+
+    // lower bound of the distance from `from` to `to`, `UNREACHABLE` when some landmark proves
+    // there is no path. defined in the header, A* calls it once per reached vertex.
+    [[nodiscard]] std::uint64_t LowerBound(std::uint64_t from, std::uint64_t to) const;
+
+ private:
+    static constexpr std::uint32_t INFINITE = 0xFFFF'FFFF;
+
+    // packing per-landmark distances (`UNREACHABLE` for no path) into `distances_`.
+    void Pack(const std::vector<std::vector<std::uint64_t>>& from_landmarks,
+              const std::vector<std::vector<std::uint64_t>>& to_landmarks);
+
+    std::size_t vertices_count_ = 0;
+    std::vector<std::uint64_t> landmarks_;
+    // for vertex `v` and landmark `i`: `[2 * (v * k + i)]` is `d(L_i, v)`, the next one `d(v, L_i)`.
+    std::vector<std::uint32_t> distances_;
+};
+
+template <BidirectionalWeightedGraph Graph>
+Landmarks::Landmarks(const Graph& graph, std::size_t count, LandmarkSelection selection, std::uint64_t seed,
+                     std::size_t threads_count)
+    : vertices_count_(graph.VerticesCount()) {
+    assert(count <= vertices_count_);
+
+    std::mt19937_64 random(seed);
+    std::vector<std::vector<std::uint64_t>> from_landmarks, to_landmarks;
+    std::vector<bool> is_landmark(vertices_count_, false);
+    auto add_landmark = [&](std::uint64_t landmark) {
+        is_landmark[landmark] = true;
+        landmarks_.push_back(landmark);
+        from_landmarks.emplace_back();
+        to_landmarks.emplace_back();
+        // the two searches are independent, the monotone radix heap is the fastest queue here.
+        ParallelFor(0, 2, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto side = begin; side < end; ++side) {
+                if (side == 0) {
+                    from_landmarks.back() = Dijkstra<RadixHeap>(graph, landmark);
+                } else {
+                    to_landmarks.back() = Dijkstra<RadixHeap>(ReversedGraph<Graph>(graph), landmark);
+                }
+            }
+        }, 1);
+    };
+
+    // bounds of the distances from `root` by the landmarks chosen so far, 0 when they say
+    // nothing. computed landmark by landmark to stream over the distance arrays.
+    auto lower_bounds = [&](std::uint64_t root) {
+        std::vector<std::uint64_t> bounds(vertices_count_, 0);
+        for (std::size_t i = 0; i < landmarks_.size(); ++i) {
+            auto from_root = from_landmarks[i][root];
+            auto to_root = to_landmarks[i][root];
+            for (std::size_t vertex = 0; vertex < vertices_count_; ++vertex) {
+                auto from_vertex = from_landmarks[i][vertex];
+                auto to_vertex = to_landmarks[i][vertex];
+                if (from_root != UNREACHABLE && from_vertex != UNREACHABLE && from_vertex > from_root) {
+                    bounds[vertex] = std::max(bounds[vertex], from_vertex - from_root);
+                }
+                if (to_root != UNREACHABLE && to_vertex != UNREACHABLE && to_root > to_vertex) {
+                    bounds[vertex] = std::max(bounds[vertex], to_root - to_vertex);
+                }
+            }
+        }
+        return bounds;
+    };
+
+    while (landmarks_.size() < count) {
+        auto root = random() % vertices_count_;
+
+        if (selection == LandmarkSelection::FARTHEST) {
+            std::vector<std::uint64_t> nearest = landmarks_.empty() ? Dijkstra<RadixHeap>(graph, root)
+                                                                    : from_landmarks.front();
+            for (std::size_t i = 1; i < landmarks_.size(); ++i) {
+                for (std::size_t vertex = 0; vertex < vertices_count_; ++vertex) {
+                    nearest[vertex] = std::min(nearest[vertex], from_landmarks[i][vertex]);
+                }
+            }
+
+            // vertices unreachable from every landmark are taken last, otherwise small stray
+            // components would use up the landmarks.
+            auto key = [&nearest](std::uint64_t vertex) {
+                return nearest[vertex] == UNREACHABLE ? 0 : nearest[vertex] + 1;
+            };
+            std::uint64_t farthest = UNREACHABLE;
+            for (std::size_t vertex = 0; vertex < vertices_count_; ++vertex) {
+                if (!is_landmark[vertex] && (farthest == UNREACHABLE || key(vertex) > key(farthest))) {
+                    farthest = vertex;
+                }
+            }
+            add_landmark(farthest);
+            continue;
+        }
+
+        // shortest path tree from `root`: the last tree edge into a vertex is its final parent.
+        struct TreeRecorder: TraversalVisitor {
+            void DiscoverVertex(std::uint64_t vertex) {
+                order.push_back(vertex);
+            }
+
+            void TreeEdge(std::uint64_t from, std::uint64_t to) {
+                parents[to] = from;
+            }
+
+            std::vector<std::uint64_t> order;
+            std::vector<std::uint64_t> parents;
+        } tree;
+        tree.parents.assign(vertices_count_, UNREACHABLE);
+        auto distances = Dijkstra<RadixHeap>(graph, root, tree);
+        auto bounds = lower_bounds(root);
+
+        // subtree sizes in reverse settle order, zero for subtrees holding a landmark.
+        std::vector<std::uint64_t> sizes(vertices_count_, 0);
+        auto has_landmark = is_landmark;
+        for (auto it = tree.order.rbegin(); it != tree.order.rend(); ++it) {
+            auto vertex = *it;
+            sizes[vertex] = has_landmark[vertex] ? 0 : sizes[vertex] + distances[vertex] - bounds[vertex];
+            if (vertex != root) {
+                auto parent = tree.parents[vertex];
+                has_landmark[parent] = has_landmark[parent] || has_landmark[vertex];
+                sizes[parent] += sizes[vertex];
+            }
+        }
+
+        // descending from the root into the heaviest subtree down to a leaf.
+        std::vector<std::uint64_t> heaviest_child(vertices_count_, UNREACHABLE);
+        for (const auto& vertex: tree.order) {
+            if (vertex == root || sizes[vertex] == 0) {
+                continue;
+            }
+            auto& child = heaviest_child[tree.parents[vertex]];
+            if (child == UNREACHABLE || sizes[vertex] > sizes[child]) {
+                child = vertex;
+            }
+        }
+
+        auto leaf = root;
+        while (heaviest_child[leaf] != UNREACHABLE) {
+            leaf = heaviest_child[leaf];
+        }
+        // every subtree is covered already, the root itself is the only candidate left.
+        if (!is_landmark[leaf]) {
+            add_landmark(leaf);
+        }
+    }
+
+    Pack(from_landmarks, to_landmarks);
+}
+
+inline std::uint64_t Landmarks::LowerBound(std::uint64_t from, std::uint64_t to) const {
+    assert(from < vertices_count_);
+    assert(to < vertices_count_);
+
+    auto count = landmarks_.size();
+    const auto* from_distances = distances_.data() + 2 * from * count;
+    const auto* to_distances = distances_.data() + 2 * to * count;
+
+    std::uint64_t bound = 0;
+    for (std::size_t i = 0; i < 2 * count; i += 2) {
+        // d(s, t) >= d(L, t) - d(L, s), and `t` is unreachable if `L` reaches `s` but not `t`.
+        if (from_distances[i] != INFINITE) {
+            if (to_distances[i] == INFINITE) {
+                return UNREACHABLE;
+            }
+            if (to_distances[i] > from_distances[i]) {
+                bound = std::max<std::uint64_t>(bound, to_distances[i] - from_distances[i]);
+            }
+        }
+        // d(s, t) >= d(s, L) - d(t, L), and `t` is unreachable if it reaches `L` but `s` does not.
+        if (to_distances[i + 1] != INFINITE) {
+            if (from_distances[i + 1] == INFINITE) {
+                return UNREACHABLE;
+            }
+            if (from_distances[i + 1] > to_distances[i + 1]) {
+                bound = std::max<std::uint64_t>(bound, from_distances[i + 1] - to_distances[i + 1]);
+            }
+        }
+    }
+
+    return bound;
+}
+
+// ALT query: A* guided by the landmark bounds to `to`.
+template <VertexQueue Queue = IndexedHeap<4>, WeightedAdjacencyGraph Graph, typename Visitor = TraversalVisitor>
+std::uint64_t AltDistance(const Graph& graph, const Landmarks& landmarks, std::uint64_t from, std::uint64_t to,
+                          Visitor&& visitor = {}) {
+    assert(landmarks.VerticesCount() == graph.VerticesCount());
+    return AStarDistance<Queue>(graph, from, to, [&landmarks, to](std::uint64_t vertex) {
+        return landmarks.LowerBound(vertex, to);
+    }, visitor);
+}
+
+}  // namespace graph
@@ -6,12 +6,53 @@
 
 namespace graph {
 
-ListGraph::ListGraph(std::size_t size): adjacency_lists_(size) {
+ListGraph::ListGraph(std::size_t size, ReverseEdges reverse_edges)
+    : adjacency_lists_(size), keeps_reverse_edges_(reverse_edges == ReverseEdges::KEEP) {
+    if (keeps_reverse_edges_) {
+        reverse_lists_.resize(size);
+    }
+}
+
+ListGraph::ListGraph(const IGraph& graph, ReverseEdges reverse_edges)
+    : ListGraph(graph.VerticesCount(), reverse_edges) {
+    std::vector<std::size_t> in_degrees(keeps_reverse_edges_ ? VerticesCount() : 0, 0);
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        std::size_t out_degree = 0;
+        graph.ForEachNextVertex(from, [&](std::uint64_t to) {
+            ++out_degree;
+            if (keeps_reverse_edges_) {
+                ++in_degrees[to];
+            }
+        });
+        adjacency_lists_[from].reserve(out_degree);
+    }
+
+    for (std::size_t to = 0; to < in_degrees.size(); ++to) {
+        reverse_lists_[to].reserve(in_degrees[to]);
+    }
+
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        graph.ForEachNextVertex(from, [this, from](std::uint64_t to) {
+            AddEdge(from, to);
+        });
+    }
 }
 
-ListGraph::ListGraph(const IGraph& graph) {
-    for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
-        adjacency_lists_[from] = graph.GetNextVertices(from);
+ListGraph::ListGraph(std::size_t size, std::span<const Edge> edges, ReverseEdges reverse_edges,
+                     std::size_t threads_count)
+    : ListGraph(size, reverse_edges) {
+    auto fill = [size, threads_count](std::vector<std::vector<std::uint64_t>>& lists, const AdjacencyArrays& arrays) {
+        ParallelFor(0, size, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto vertex = begin; vertex < end; ++vertex) {
+                lists[vertex].assign(arrays.vertices.begin() + arrays.offsets[vertex],
+                                     arrays.vertices.begin() + arrays.offsets[vertex + 1]);
+            }
+        });
+    };
+
+    fill(adjacency_lists_, GroupBySource(size, edges, threads_count));
+    if (keeps_reverse_edges_) {
+        fill(reverse_lists_, GroupByTarget(size, edges, threads_count));
     }
 }
 
@@ -19,12 +60,19 @@ void ListGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
     assert(from < VerticesCount());
     assert(to < VerticesCount());
     adjacency_lists_[from].push_back(to);
+    if (keeps_reverse_edges_) {
+        reverse_lists_[to].push_back(from);
+    }
 }
 
 [[nodiscard]] std::size_t ListGraph::VerticesCount() const {
     return adjacency_lists_.size();
 }
 
+[[nodiscard]] bool ListGraph::KeepsReverseEdges() const {
+    return keeps_reverse_edges_;
+}
+
 [[nodiscard]] std::vector<std::uint64_t> ListGraph::GetNextVertices(std::uint64_t vertex) const {
     assert(vertex < VerticesCount());
     return adjacency_lists_[vertex];
@@ -33,6 +81,10 @@ void ListGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
 [[nodiscard]] std::vector<std::uint64_t> ListGraph::GetPrevVertices(std::uint64_t vertex) const {
     assert(vertex < VerticesCount());
 
+    if (keeps_reverse_edges_) {
+        return reverse_lists_[vertex];
+    }
+
     std::vector<std::uint64_t> prev_vertices;
     for (std::size_t from = 0; from < VerticesCount(); ++from) {
         for (std::size_t to: adjacency_lists_[from]) {
@@ -45,4 +97,12 @@ void ListGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
     return prev_vertices;
 }
 
+void ListGraph::ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachNextVertex<VertexVisitor&>(vertex, visitor);
+}
+
+void ListGraph::ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachPrevVertex<VertexVisitor&>(vertex, visitor);
+}
+
 }  // namespace graph
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "base.hpp"
+#include "edge_list.hpp"
+#include "parallel.hpp"
 
+#include <cassert>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 
@@ -10,20 +14,67 @@ namespace graph {
 
 class ListGraph: public IGraph {
  public:
-    explicit ListGraph(std::size_t size);
+    explicit ListGraph(std::size_t size, ReverseEdges reverse_edges = ReverseEdges::SKIP);
 
-    explicit ListGraph(const IGraph& graph);
+    explicit ListGraph(const IGraph& graph, ReverseEdges reverse_edges = ReverseEdges::SKIP);
+
+    // bulk construction, every adjacency list is allocated once with its final size.
+    ListGraph(std::size_t size, std::span<const Edge> edges, ReverseEdges reverse_edges = ReverseEdges::SKIP,
+              std::size_t threads_count = DefaultThreadsCount());
 
     void AddEdge(std::uint64_t from, std::uint64_t to) override;
 
     [[nodiscard]] std::size_t VerticesCount() const override;
 
+    [[nodiscard]] bool KeepsReverseEdges() const;
+
     [[nodiscard]] std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const override;
 
     [[nodiscard]] std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const override;
 
+    void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    template <typename Visitor>
+    void ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    template <typename Visitor>
+    void ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
  private:
     std::vector<std::vector<std::uint64_t>> adjacency_lists_;
+    // empty unless built with `ReverseEdges::KEEP`.
+    std::vector<std::vector<std::uint64_t>> reverse_lists_;
+    bool keeps_reverse_edges_;
 };
 
+template <typename Visitor>
+void ListGraph::ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+    for (const auto& to: adjacency_lists_[vertex]) {
+        visitor(to);
+    }
+}
+
+template <typename Visitor>
+void ListGraph::ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+
+    if (keeps_reverse_edges_) {
+        for (const auto& from: reverse_lists_[vertex]) {
+            visitor(from);
+        }
+        return;
+    }
+
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        for (const auto& to: adjacency_lists_[from]) {
+            if (to == vertex) {
+                visitor(from);
+            }
+        }
+    }
+}
+
 }  // namespace graph
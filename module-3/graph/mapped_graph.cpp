@@ -0,0 +1,390 @@
+#include "mapped_graph.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+
+namespace graph {
+
+namespace {
+
+std::uint64_t AlignUp(std::uint64_t offset) {
+    return (offset + BinaryGraphHeader::ALIGNMENT - 1) / BinaryGraphHeader::ALIGNMENT * BinaryGraphHeader::ALIGNMENT;
+}
+
+class BinaryWriter {
+ public:
+    explicit BinaryWriter(const std::filesystem::path& path): path_(path), output_(path, std::ios::binary) {
+        if (!output_) {
+            throw std::system_error(errno, std::generic_category(), "can not open " + path.string());
+        }
+    }
+
+    template <typename T>
+    void Write(const T& value) {
+        Write(std::span<const T>(&value, 1));
+    }
+
+    template <typename T>
+    void Write(std::span<const T> values) {
+        output_.write(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+        position_ += values.size_bytes();
+    }
+
+    // padding with zeros up to the section starting at `offset`.
+    void Seek(std::uint64_t offset) {
+        assert(offset >= position_);
+        static const char zeros[BinaryGraphHeader::ALIGNMENT] = {};
+        output_.write(zeros, offset - position_);
+        position_ = offset;
+    }
+
+    void Close() {
+        output_.close();
+        if (!output_) {
+            throw std::runtime_error("failed to write graph to " + path_.string());
+        }
+    }
+
+ private:
+    std::filesystem::path path_;
+    std::ofstream output_;
+    std::uint64_t position_ = 0;
+};
+
+// `weights` is empty for an unweighted graph, an empty span is the weights of a graph without edges.
+void WriteBinaryGraph(const IGraph& graph, std::optional<std::span<const std::uint64_t>> weights,
+                      const std::filesystem::path& path, ReverseEdges reverse_edges) {
+    auto vertices_count = graph.VerticesCount();
+
+    std::vector<std::uint64_t> next_offsets(vertices_count + 1, 0);
+    std::vector<std::uint64_t> prev_offsets;
+    if (reverse_edges == ReverseEdges::KEEP) {
+        prev_offsets.assign(vertices_count + 1, 0);
+    }
+
+    for (std::size_t from = 0; from < vertices_count; ++from) {
+        next_offsets[from + 1] = next_offsets[from];
+        graph.ForEachNextVertex(from, [&](std::uint64_t to) {
+            ++next_offsets[from + 1];
+            if (!prev_offsets.empty()) {
+                ++prev_offsets[to + 1];
+            }
+        });
+    }
+
+    auto edges_count = next_offsets.back();
+    if (weights.has_value() && weights->size() != edges_count) {
+        throw std::invalid_argument("graph has " + std::to_string(edges_count) + " edges, but "
+                                    + std::to_string(weights->size()) + " weights are given");
+    }
+
+    BinaryGraphHeader header{};
+    header.magic = BinaryGraphHeader::MAGIC;
+    header.version = BinaryGraphHeader::VERSION;
+    header.vertices_count = vertices_count;
+    header.edges_count = edges_count;
+
+    auto offsets_bytes = (vertices_count + 1) * sizeof(std::uint64_t);
+    auto edges_bytes = edges_count * sizeof(std::uint64_t);
+
+    auto offset = AlignUp(sizeof(header));
+    auto allocate = [&offset](std::uint64_t bytes) {
+        auto section = offset;
+        offset = AlignUp(offset + bytes);
+        return section;
+    };
+
+    header.next_offsets = allocate(offsets_bytes);
+    header.next_vertices = allocate(edges_bytes);
+    if (weights.has_value()) {
+        header.flags |= BinaryGraphHeader::HAS_WEIGHTS;
+        header.next_weights = allocate(edges_bytes);
+    }
+    if (!prev_offsets.empty()) {
+        header.flags |= BinaryGraphHeader::HAS_REVERSE_EDGES;
+        header.prev_offsets = allocate(offsets_bytes);
+        header.prev_vertices = allocate(edges_bytes);
+        if (weights.has_value()) {
+            header.prev_weights = allocate(edges_bytes);
+        }
+    }
+
+    BinaryWriter writer(path);
+    writer.Write(header);
+
+    writer.Seek(header.next_offsets);
+    writer.Write(std::span<const std::uint64_t>(next_offsets));
+
+    writer.Seek(header.next_vertices);
+    std::vector<std::uint64_t> buffer;
+    for (std::size_t from = 0; from < vertices_count; ++from) {
+        buffer.clear();
+        graph.ForEachNextVertex(from, [&buffer](std::uint64_t to) {
+            buffer.push_back(to);
+        });
+        writer.Write(std::span<const std::uint64_t>(buffer));
+    }
+
+    if (weights.has_value()) {
+        writer.Seek(header.next_weights);
+        writer.Write(*weights);
+    }
+
+    if (!prev_offsets.empty()) {
+        for (std::size_t vertex = 0; vertex < vertices_count; ++vertex) {
+            prev_offsets[vertex + 1] += prev_offsets[vertex];
+        }
+
+        std::vector<std::uint64_t> prev_vertices(edges_count);
+        std::vector<std::uint64_t> prev_weights(weights.has_value() ? edges_count : 0);
+        std::vector<std::uint64_t> cursor(prev_offsets.begin(), prev_offsets.end() - 1);
+        std::uint64_t edge = 0;
+        for (std::size_t from = 0; from < vertices_count; ++from) {
+            graph.ForEachNextVertex(from, [&](std::uint64_t to) {
+                auto position = cursor[to]++;
+                prev_vertices[position] = from;
+                if (weights.has_value()) {
+                    prev_weights[position] = (*weights)[edge];
+                }
+                ++edge;
+            });
+        }
+
+        writer.Seek(header.prev_offsets);
+        writer.Write(std::span<const std::uint64_t>(prev_offsets));
+        writer.Seek(header.prev_vertices);
+        writer.Write(std::span<const std::uint64_t>(prev_vertices));
+        if (weights.has_value()) {
+            writer.Seek(header.prev_weights);
+            writer.Write(std::span<const std::uint64_t>(prev_weights));
+        }
+    }
+
+    writer.Seek(offset);
+    writer.Close();
+}
+
+}  // namespace
+
+void WriteBinaryGraph(const IGraph& graph, const std::filesystem::path& path, ReverseEdges reverse_edges) {
+    WriteBinaryGraph(graph, std::nullopt, path, reverse_edges);
+}
+
+void WriteBinaryGraph(const IGraph& graph, std::span<const std::uint64_t> weights,
+                      const std::filesystem::path& path, ReverseEdges reverse_edges) {
+    WriteBinaryGraph(graph, std::optional(weights), path, reverse_edges);
+}
+
+MappedGraph::MappedGraph(const std::filesystem::path& path) {
+    auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "can not open " + path.string());
+    }
+
+    struct stat file_stat{};
+    if (::fstat(fd, &file_stat) != 0) {
+        auto error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "can not stat " + path.string());
+    }
+
+    size_ = file_stat.st_size;
+    if (size_ < sizeof(BinaryGraphHeader)) {
+        ::close(fd);
+        throw std::runtime_error(path.string() + " is too small to be a graph");
+    }
+
+    auto* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    auto error = errno;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "can not map " + path.string());
+    }
+    data_ = static_cast<const std::byte*>(mapping);
+
+    std::memcpy(&header_, data_, sizeof(header_));
+    if (header_.magic != BinaryGraphHeader::MAGIC || header_.version != BinaryGraphHeader::VERSION) {
+        Unmap();
+        throw std::runtime_error(path.string() + " is not a graph of version "
+                                 + std::to_string(BinaryGraphHeader::VERSION));
+    }
+
+    auto max_count = size_ / sizeof(std::uint64_t);
+    if (header_.vertices_count >= max_count || header_.edges_count > max_count) {
+        Unmap();
+        throw std::runtime_error(path.string() + " is truncated");
+    }
+
+    auto offsets_bytes = (header_.vertices_count + 1) * sizeof(std::uint64_t);
+    auto edges_bytes = header_.edges_count * sizeof(std::uint64_t);
+    auto fits = [this](std::uint64_t offset, std::uint64_t bytes) {
+        return offset % BinaryGraphHeader::ALIGNMENT == 0 && offset >= sizeof(header_)
+               && offset <= size_ && bytes <= size_ - offset;
+    };
+
+    bool valid = fits(header_.next_offsets, offsets_bytes) && fits(header_.next_vertices, edges_bytes);
+    if (HasWeights()) {
+        valid = valid && fits(header_.next_weights, edges_bytes);
+    }
+    if (HasReverseEdges()) {
+        valid = valid && fits(header_.prev_offsets, offsets_bytes) && fits(header_.prev_vertices, edges_bytes);
+        if (HasWeights()) {
+            valid = valid && fits(header_.prev_weights, edges_bytes);
+        }
+    }
+
+    if (!valid) {
+        Unmap();
+        throw std::runtime_error(path.string() + " has a truncated or corrupted section table");
+    }
+
+    next_offsets_ = Section(header_.next_offsets);
+    next_vertices_ = Section(header_.next_vertices);
+    // the views index the mapping by the offsets, so they must cut [0, E) into consecutive ranges.
+    auto consistent = [this](const std::uint64_t* offsets) {
+        for (std::uint64_t vertex = 0; vertex < header_.vertices_count; ++vertex) {
+            if (offsets[vertex] > offsets[vertex + 1]) {
+                return false;
+            }
+        }
+        return offsets[0] == 0 && offsets[header_.vertices_count] == header_.edges_count;
+    };
+    valid = consistent(next_offsets_);
+    if (HasWeights()) {
+        next_weights_ = Section(header_.next_weights);
+    }
+    if (HasReverseEdges()) {
+        prev_offsets_ = Section(header_.prev_offsets);
+        prev_vertices_ = Section(header_.prev_vertices);
+        if (HasWeights()) {
+            prev_weights_ = Section(header_.prev_weights);
+        }
+        valid = valid && consistent(prev_offsets_);
+    }
+
+    if (!valid) {
+        Unmap();
+        throw std::runtime_error(path.string() + " has corrupted offsets");
+    }
+}
+
+MappedGraph::MappedGraph(MappedGraph&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedGraph& MappedGraph::operator = (MappedGraph&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    Unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    header_ = std::exchange(other.header_, BinaryGraphHeader{});
+    next_offsets_ = std::exchange(other.next_offsets_, nullptr);
+    next_vertices_ = std::exchange(other.next_vertices_, nullptr);
+    next_weights_ = std::exchange(other.next_weights_, nullptr);
+    prev_offsets_ = std::exchange(other.prev_offsets_, nullptr);
+    prev_vertices_ = std::exchange(other.prev_vertices_, nullptr);
+    prev_weights_ = std::exchange(other.prev_weights_, nullptr);
+
+    return *this;
+}
+
+MappedGraph::~MappedGraph() {
+    Unmap();
+}
+
+void MappedGraph::AddEdge(std::uint64_t, std::uint64_t) {
+    throw std::logic_error("graph::MappedGraph is read-only");
+}
+
+[[nodiscard]] std::size_t MappedGraph::VerticesCount() const {
+    return header_.vertices_count;
+}
+
+[[nodiscard]] std::size_t MappedGraph::EdgesCount() const {
+    return header_.edges_count;
+}
+
+[[nodiscard]] bool MappedGraph::HasWeights() const {
+    return header_.flags & BinaryGraphHeader::HAS_WEIGHTS;
+}
+
+[[nodiscard]] bool MappedGraph::HasReverseEdges() const {
+    return header_.flags & BinaryGraphHeader::HAS_REVERSE_EDGES;
+}
+
+[[nodiscard]] std::vector<std::uint64_t> MappedGraph::GetNextVertices(std::uint64_t vertex) const {
+    auto next_vertices = GetNextVerticesView(vertex);
+    return {next_vertices.begin(), next_vertices.end()};
+}
+
+[[nodiscard]] std::vector<std::uint64_t> MappedGraph::GetPrevVertices(std::uint64_t vertex) const {
+    std::vector<std::uint64_t> prev_vertices;
+    ForEachPrevVertex(vertex, [&prev_vertices](std::uint64_t from) {
+        prev_vertices.push_back(from);
+    });
+
+    return prev_vertices;
+}
+
+void MappedGraph::ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachNextVertex<VertexVisitor&>(vertex, visitor);
+}
+
+void MappedGraph::ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachPrevVertex<VertexVisitor&>(vertex, visitor);
+}
+
+[[nodiscard]] std::span<const std::uint64_t> MappedGraph::GetNextVerticesView(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return {next_vertices_ + next_offsets_[vertex], next_vertices_ + next_offsets_[vertex + 1]};
+}
+
+[[nodiscard]] std::span<const std::uint64_t> MappedGraph::GetNextWeightsView(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    assert(HasWeights());
+    return {next_weights_ + next_offsets_[vertex], next_weights_ + next_offsets_[vertex + 1]};
+}
+
+[[nodiscard]] std::span<const std::uint64_t> MappedGraph::GetPrevVerticesView(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    assert(HasReverseEdges());
+    return {prev_vertices_ + prev_offsets_[vertex], prev_vertices_ + prev_offsets_[vertex + 1]};
+}
+
+[[nodiscard]] std::span<const std::uint64_t> MappedGraph::GetPrevWeightsView(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    assert(HasReverseEdges() && HasWeights());
+    return {prev_weights_ + prev_offsets_[vertex], prev_weights_ + prev_offsets_[vertex + 1]};
+}
+
+[[nodiscard]] const std::uint64_t* MappedGraph::Section(std::uint64_t offset) const {
+    return reinterpret_cast<const std::uint64_t*>(data_ + offset);
+}
+
+void MappedGraph::Unmap() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+}  // namespace graph
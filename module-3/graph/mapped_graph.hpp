@@ -0,0 +1,150 @@
+#pragma once
+
+#include "base.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// on-disk graph layout, all integers are native-endian and every section starts
+// at a multiple of `BinaryGraphHeader::ALIGNMENT` bytes from the file start:
+//
+//   header | next offsets [V + 1] | next vertices [E] | next weights [E]?
+//          | prev offsets [V + 1] | prev vertices [E] | prev weights [E]?
+//
+// offsets, vertices and weights are uint64. weights and the reverse (prev) index
+// are optional and marked in `flags`.
+struct BinaryGraphHeader {
+    static constexpr std::uint64_t MAGIC = 0x0048'5041'5247'4B56;  // "VKGRAPH\0" on little-endian
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint64_t ALIGNMENT = 64;
+
+    static constexpr std::uint32_t HAS_WEIGHTS = 1 << 0;
+    static constexpr std::uint32_t HAS_REVERSE_EDGES = 1 << 1;
+
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint64_t vertices_count;
+    std::uint64_t edges_count;
+
+    // byte offsets of the sections, zero for absent ones.
+    std::uint64_t next_offsets;
+    std::uint64_t next_vertices;
+    std::uint64_t next_weights;
+    std::uint64_t prev_offsets;
+    std::uint64_t prev_vertices;
+    std::uint64_t prev_weights;
+};
+
+// dumping `graph` in the format above. neighbours keep the `ForEachNextVertex` order.
+void WriteBinaryGraph(const IGraph& graph, const std::filesystem::path& path,
+                      ReverseEdges reverse_edges = ReverseEdges::KEEP);
+
+// same, `weights` are given per edge in the `ForEachNextVertex` order of all vertices.
+// throws `std::invalid_argument` if their count differs from the edges count.
+void WriteBinaryGraph(const IGraph& graph, std::span<const std::uint64_t> weights,
+                      const std::filesystem::path& path, ReverseEdges reverse_edges = ReverseEdges::KEEP);
+
+// read-only graph served straight from a memory-mapped file written by
+// `WriteBinaryGraph`: opening it validates the section table and the offsets in O(V),
+// the edges are only read on access. the targets are trusted, checking them would read
+// the whole file, so a corrupted target may still be out of `[0, V)`.
+class MappedGraph: public IGraph {
+ public:
+    explicit MappedGraph(const std::filesystem::path& path);
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator = (const MappedGraph&) = delete;
+
+    // `other` is left as an empty graph.
+    MappedGraph(MappedGraph&& other) noexcept;
+    MappedGraph& operator = (MappedGraph&& other) noexcept;
+
+    ~MappedGraph() override;
+
+    // throws `std::logic_error`, the mapping is read-only.
+    void AddEdge(std::uint64_t from, std::uint64_t to) override;
+
+    [[nodiscard]] std::size_t VerticesCount() const override;
+
+    [[nodiscard]] std::size_t EdgesCount() const;
+
+    [[nodiscard]] bool HasWeights() const;
+
+    [[nodiscard]] bool HasReverseEdges() const;
+
+    [[nodiscard]] std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const override;
+
+    // O(E) unless the file has the reverse index.
+    [[nodiscard]] std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const override;
+
+    void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    template <typename Visitor>
+    void ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    template <typename Visitor>
+    void ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    [[nodiscard]] std::span<const std::uint64_t> GetNextVerticesView(std::uint64_t vertex) const;
+
+    [[nodiscard]] std::span<const std::uint64_t> GetNextWeightsView(std::uint64_t vertex) const;
+
+    // require `HasReverseEdges()`.
+    [[nodiscard]] std::span<const std::uint64_t> GetPrevVerticesView(std::uint64_t vertex) const;
+
+    [[nodiscard]] std::span<const std::uint64_t> GetPrevWeightsView(std::uint64_t vertex) const;
+
+ private:
+    [[nodiscard]] const std::uint64_t* Section(std::uint64_t offset) const;
+
+    void Unmap();
+
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    BinaryGraphHeader header_{};
+
+    const std::uint64_t* next_offsets_ = nullptr;
+    const std::uint64_t* next_vertices_ = nullptr;
+    const std::uint64_t* next_weights_ = nullptr;
+    const std::uint64_t* prev_offsets_ = nullptr;
+    const std::uint64_t* prev_vertices_ = nullptr;
+    const std::uint64_t* prev_weights_ = nullptr;
+};
+
+template <typename Visitor>
+void MappedGraph::ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    for (const auto& to: GetNextVerticesView(vertex)) {
+        visitor(to);
+    }
+}
+
+template <typename Visitor>
+void MappedGraph::ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+
+    if (HasReverseEdges()) {
+        for (const auto& from: GetPrevVerticesView(vertex)) {
+            visitor(from);
+        }
+        return;
+    }
+
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        for (const auto& to: GetNextVerticesView(from)) {
+            if (to == vertex) {
+                visitor(from);
+            }
+        }
+    }
+}
+
+}  // namespace graph
@@ -1,46 +1,74 @@
 #include "matrix_graph.hpp"
 
+#include <atomic>
+#include <bit>
 #include <cassert>
 #include <cstdint>
 
 
 namespace graph {
 
-MatrixGraph::MatrixGraph(std::size_t size): adjacency_matrix_(size) {
-    for (auto& row: adjacency_matrix_) {
-        row.resize(size, false);
-    }
+namespace {
+
+// rows are padded to a whole number of 64-byte cache lines.
+constexpr std::size_t CACHE_LINE_WORDS = 64 / sizeof(std::uint64_t);
+
+std::size_t GetRowWords(std::size_t size) {
+    auto words = (size + MatrixGraph::WORD_BITS - 1) / MatrixGraph::WORD_BITS;
+    return (words + CACHE_LINE_WORDS - 1) / CACHE_LINE_WORDS * CACHE_LINE_WORDS;
+}
+
+}  // namespace
+
+MatrixGraph::MatrixGraph(std::size_t size)
+    : vertices_count_(size), row_words_(GetRowWords(size)), adjacency_matrix_(size * row_words_, 0) {
 }
 
-MatrixGraph::MatrixGraph(const IGraph& graph): adjacency_matrix_(graph.VerticesCount()) {
+MatrixGraph::MatrixGraph(const IGraph& graph): MatrixGraph(graph.VerticesCount()) {
     for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
-        adjacency_matrix_[from].resize(graph.VerticesCount(), false);
-        auto to_vertices = graph.GetNextVertices(from);
-        for (const auto& to: to_vertices) {
-            adjacency_matrix_[from][to] = true;
-        }
+        graph.ForEachNextVertex(from, [this, from](std::uint64_t to) {
+            AddEdge(from, to);
+        });
     }
 }
 
+MatrixGraph::MatrixGraph(std::size_t size, std::span<const Edge> edges, std::size_t threads_count)
+    : MatrixGraph(size) {
+    ParallelFor(0, edges.size(), threads_count, [this, edges](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto [from, to] = edges[i];
+            assert(from < VerticesCount());
+            assert(to < VerticesCount());
+            std::atomic_ref<std::uint64_t>(adjacency_matrix_[from * row_words_ + to / WORD_BITS])
+                .fetch_or(std::uint64_t{1} << (to % WORD_BITS), std::memory_order_relaxed);
+        }
+    }, 1 << 16);
+}
+
 void MatrixGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
     assert(from < VerticesCount());
     assert(to < VerticesCount());
-    adjacency_matrix_[from][to] = true;
+    adjacency_matrix_[from * row_words_ + to / WORD_BITS] |= std::uint64_t{1} << (to % WORD_BITS);
+}
+
+[[nodiscard]] bool MatrixGraph::HasEdge(std::uint64_t from, std::uint64_t to) const {
+    assert(from < VerticesCount());
+    assert(to < VerticesCount());
+    return (adjacency_matrix_[from * row_words_ + to / WORD_BITS] >> (to % WORD_BITS)) & 1;
 }
 
 [[nodiscard]] std::size_t MatrixGraph::VerticesCount() const {
-    return adjacency_matrix_.size();
+    return vertices_count_;
 }
 
 [[nodiscard]] std::vector<std::uint64_t> MatrixGraph::GetNextVertices(std::uint64_t vertex) const {
     assert(vertex < VerticesCount());
 
     std::vector<std::uint64_t> next_vertices;
-    for (std::size_t to = 0; to < VerticesCount(); ++to) {
-        if (adjacency_matrix_[vertex][to]) {
-            next_vertices.push_back(to);
-        }
-    }
+    next_vertices.reserve(RowPopcount(vertex));
+    ForEachNextVertex(vertex, [&next_vertices](std::uint64_t to) {
+        next_vertices.push_back(to);
+    });
 
     return next_vertices;
 }
@@ -49,13 +77,64 @@ void MatrixGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
     assert(vertex < VerticesCount());
 
     std::vector<std::uint64_t> prev_vertices;
-    for (std::size_t from = 0; from < VerticesCount(); ++from) {
-        if (adjacency_matrix_[from][vertex]) {
-            prev_vertices.push_back(from);
-        }
-    }
+    ForEachPrevVertex(vertex, [&prev_vertices](std::uint64_t from) {
+        prev_vertices.push_back(from);
+    });
 
     return prev_vertices;
 }
 
-}  // namespace graph
\ No newline at end of file
+void MatrixGraph::ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachNextVertex<VertexVisitor&>(vertex, visitor);
+}
+
+void MatrixGraph::ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachPrevVertex<VertexVisitor&>(vertex, visitor);
+}
+
+[[nodiscard]] std::size_t MatrixGraph::RowWords() const {
+    return row_words_;
+}
+
+[[nodiscard]] std::span<const std::uint64_t> MatrixGraph::Row(std::uint64_t vertex) const {
+    assert(vertex < VerticesCount());
+    return {adjacency_matrix_.data() + vertex * row_words_, row_words_};
+}
+
+void MatrixGraph::OrRow(std::uint64_t vertex, std::span<std::uint64_t> bits) const {
+    assert(bits.size() == row_words_);
+
+    auto row = Row(vertex);
+    for (std::size_t i = 0; i < row_words_; ++i) {
+        bits[i] |= row[i];
+    }
+}
+
+void MatrixGraph::AndRow(std::uint64_t vertex, std::span<std::uint64_t> bits) const {
+    assert(bits.size() == row_words_);
+
+    auto row = Row(vertex);
+    for (std::size_t i = 0; i < row_words_; ++i) {
+        bits[i] &= row[i];
+    }
+}
+
+void MatrixGraph::AndNotRow(std::uint64_t vertex, std::span<std::uint64_t> bits) const {
+    assert(bits.size() == row_words_);
+
+    auto row = Row(vertex);
+    for (std::size_t i = 0; i < row_words_; ++i) {
+        bits[i] &= ~row[i];
+    }
+}
+
+[[nodiscard]] std::size_t MatrixGraph::RowPopcount(std::uint64_t vertex) const {
+    std::size_t count = 0;
+    for (const auto& word: Row(vertex)) {
+        count += std::popcount(word);
+    }
+
+    return count;
+}
+
+}  // namespace graph
@@ -1,29 +1,96 @@
 #pragma once
 
+#include "aligned_allocator.hpp"
 #include "base.hpp"
+#include "edge_list.hpp"
+#include "parallel.hpp"
 
+#include <bit>
+#include <cassert>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 
 namespace graph {
 
+// adjacency matrix packed into one contiguous bitset. every row starts on its own
+// cache line, so rows can be combined word by word with frontier bitsets.
 class MatrixGraph: public IGraph {
  public:
+    static constexpr std::size_t WORD_BITS = 64;
+
     explicit MatrixGraph(std::size_t size);
 
     explicit MatrixGraph(const IGraph& graph);
 
+    // bits are set in parallel with atomic word updates.
+    MatrixGraph(std::size_t size, std::span<const Edge> edges, std::size_t threads_count = DefaultThreadsCount());
+
     void AddEdge(std::uint64_t from, std::uint64_t to) override;
 
+    [[nodiscard]] bool HasEdge(std::uint64_t from, std::uint64_t to) const;
+
     [[nodiscard]] std::size_t VerticesCount() const override;
 
     [[nodiscard]] std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const override;
 
     [[nodiscard]] std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const override;
 
+    void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    template <typename Visitor>
+    void ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    template <typename Visitor>
+    void ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    // count of 64-bit words in a row, bitsets passed to row operations must have this size.
+    [[nodiscard]] std::size_t RowWords() const;
+
+    [[nodiscard]] std::span<const std::uint64_t> Row(std::uint64_t vertex) const;
+
+    // `bits |= row(vertex)`.
+    void OrRow(std::uint64_t vertex, std::span<std::uint64_t> bits) const;
+
+    // `bits &= row(vertex)`.
+    void AndRow(std::uint64_t vertex, std::span<std::uint64_t> bits) const;
+
+    // `bits &= ~row(vertex)`.
+    void AndNotRow(std::uint64_t vertex, std::span<std::uint64_t> bits) const;
+
+    // out-degree of `vertex`.
+    [[nodiscard]] std::size_t RowPopcount(std::uint64_t vertex) const;
+
  private:
-    std::vector<std::vector<bool>> adjacency_matrix_;
+    std::size_t vertices_count_;
+    std::size_t row_words_;
+    std::vector<std::uint64_t, AlignedAllocator<std::uint64_t>> adjacency_matrix_;
 };
 
+template <typename Visitor>
+void MatrixGraph::ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+
+    auto row = Row(vertex);
+    for (std::size_t i = 0; i < row.size(); ++i) {
+        for (auto word = row[i]; word != 0; word &= word - 1) {
+            visitor(i * WORD_BITS + std::countr_zero(word));
+        }
+    }
+}
+
+template <typename Visitor>
+void MatrixGraph::ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        if (HasEdge(from, vertex)) {
+            visitor(from);
+        }
+    }
+}
+
 }  // namespace graph
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "base.hpp"
+#include "parallel.hpp"
+#include "paths_count.hpp"
+#include "traversal.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace graph {
+
+// whether `MultiSourceBFS` counts shortest paths besides the distances.
+enum class PathCounts {
+    SKIP,
+    KEEP
+};
+
+// memory the path counters of all `MultiSourceBFS` threads may take together.
+constexpr std::size_t MULTI_SOURCE_BFS_COUNTS_BYTES = std::size_t{1} << 30;
+
+// sources of a `MultiSourceBFS` batch, bit `i` stands for the `i`-th source of the batch. the
+// word loops have no dependencies between words, so the compiler turns them into vector
+// instructions as wide as the target allows.
+template <std::size_t Width>
+struct alignas(std::min<std::size_t>(Width / 8, 64)) SourceSet {
+    static constexpr std::size_t WORDS = Width / 64;
+
+    std::array<std::uint64_t, WORDS> words{};
+
+    [[nodiscard]] bool Any() const {
+        std::uint64_t any = 0;
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            any |= words[i];
+        }
+        return any != 0;
+    }
+
+    // calls `visitor(i)` for every source `i` in the set.
+    template <typename Visitor>
+    void ForEach(Visitor&& visitor) const {
+        for (std::size_t i = 0; i < WORDS; ++i) {
+            for (auto word = words[i]; word != 0; word &= word - 1) {
+                visitor(i * 64 + static_cast<std::size_t>(std::countr_zero(word)));
+            }
+        }
+    }
+};
+
+// multi-source bfs (Then et al., "The More the Merrier"): the sources are split into batches
+// of `Width` (64, 256 or 512) and every batch is traversed at once. each vertex keeps bitsets
+// of the sources that have seen it and of those whose frontier it is on, so an edge is scanned
+// once per level for the whole batch instead of once per source, and the bit operations cover
+// `Width` sources per pass.
+//
+// the results are batch-major: `visitor(first, vertex, level, reached, counts)` is called once
+// per vertex and level at which some sources of a batch reach it. `first` is the index in
+// `sources` of the first source of the batch and `reached` holds `i` for `sources[first + i]`.
+// with `PathCounts::KEEP`, `counts[i]` is the number of its shortest paths to `vertex` modulo
+// 2^64, otherwise `counts` is empty; it is valid only during the call. batches run in parallel,
+// so the visitor is called from several threads at once, but never for the same batch.
+//
+// each thread keeps 3 * `Width` bits per vertex and with `PathCounts::KEEP` also `Width`
+// counters per vertex: in a small-world graph almost every vertex is on the frontier of some
+// source of a batch, so a batch can not do with fewer. the threads are limited to keep all
+// counters within `MULTI_SOURCE_BFS_COUNTS_BYTES`, but one always runs, so a graph too large
+// for that needs a smaller `Width`. counting takes an addition per edge and source, unlike the
+// bit operations it does not get faster with `Width`.
+template <std::size_t Width = 64, AdjacencyGraph Graph, typename Visitor>
+    requires std::invocable<Visitor&, std::size_t, std::uint64_t, std::uint64_t, const SourceSet<Width>&,
+                            std::span<const std::uint64_t>>
+void MultiSourceBFS(const Graph& graph, std::span<const std::uint64_t> sources, Visitor&& visitor,
+                    PathCounts path_counts = PathCounts::SKIP, std::size_t threads_count = DefaultThreadsCount()) {
+    static_assert(Width == 64 || Width == 256 || Width == 512);
+    using Set = SourceSet<Width>;
+
+    auto vertices_count = graph.VerticesCount();
+    auto keep_counts = path_counts == PathCounts::KEEP;
+    auto batches_count = (sources.size() + Width - 1) / Width;
+    if (keep_counts) {
+        auto thread_bytes = std::max<std::size_t>(vertices_count * Width * sizeof(std::uint64_t), 1);
+        threads_count = std::min(threads_count, MULTI_SOURCE_BFS_COUNTS_BYTES / thread_bytes);
+    }
+    threads_count = std::clamp<std::size_t>(threads_count, 1, std::max<std::size_t>(batches_count, 1));
+
+    struct State {
+        // sources that have reached a vertex, that have it on the current and on the next frontier.
+        std::vector<Set> seen;
+        std::vector<Set> visit;
+        std::vector<Set> next;
+        std::vector<std::uint64_t> frontier;
+        std::vector<std::uint64_t> next_frontier;
+        // path counts of the batch, vertex-major so that one edge updates adjacent counters.
+        std::vector<std::uint64_t> counts;
+    };
+    std::vector<State> states(threads_count);
+
+    ParallelFor(0, batches_count, threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        auto& [seen, visit, next, frontier, next_frontier, counts] = states[thread];
+        seen.resize(vertices_count);
+        visit.resize(vertices_count);
+        next.resize(vertices_count);
+        if (keep_counts) {
+            counts.resize(vertices_count * Width);
+        }
+        // the counters of `vertex`, empty without path counts.
+        auto row = [&counts, keep_counts](std::uint64_t vertex) {
+            return keep_counts ? std::span<const std::uint64_t>(counts.data() + vertex * Width, Width)
+                               : std::span<const std::uint64_t>();
+        };
+
+        for (auto batch = begin; batch < end; ++batch) {
+            auto first = batch * Width;
+            auto batch_size = std::min(Width, sources.size() - first);
+
+            std::fill(seen.begin(), seen.end(), Set{});
+            std::fill(counts.begin(), counts.end(), 0);
+            frontier.clear();
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                auto source = sources[first + i];
+                assert(source < vertices_count);
+                if (keep_counts) {
+                    counts[source * Width + i] = 1;
+                }
+
+                if (!visit[source].Any()) {
+                    frontier.push_back(source);
+                }
+                seen[source].words[i / 64] |= std::uint64_t{1} << (i % 64);
+                visit[source].words[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+            for (const auto& vertex: frontier) {
+                visitor(first, vertex, std::uint64_t{0}, std::as_const(visit[vertex]), row(vertex));
+            }
+
+            for (std::uint64_t level = 1; !frontier.empty(); ++level) {
+                // `seen` is only updated after the level, so `visit & ~seen` are the sources for
+                // which the neighbour is at this level, whichever frontier vertex reaches it first.
+                for (const auto& vertex: frontier) {
+                    const auto& bits = visit[vertex];
+                    graph.ForEachNextVertex(vertex, [&](std::uint64_t to) {
+                        Set fresh;
+                        for (std::size_t i = 0; i < Set::WORDS; ++i) {
+                            fresh.words[i] = bits.words[i] & ~seen[to].words[i];
+                        }
+                        if (!fresh.Any()) {
+                            return;
+                        }
+
+                        if (!next[to].Any()) {
+                            next_frontier.push_back(to);
+                        }
+                        for (std::size_t i = 0; i < Set::WORDS; ++i) {
+                            next[to].words[i] |= fresh.words[i];
+                        }
+                        if (keep_counts) {
+                            fresh.ForEach([&](std::size_t i) {
+                                counts[to * Width + i] += counts[vertex * Width + i];
+                            });
+                        }
+                    });
+                }
+                for (const auto& vertex: frontier) {
+                    visit[vertex] = Set{};
+                }
+
+                for (const auto& vertex: next_frontier) {
+                    for (std::size_t i = 0; i < Set::WORDS; ++i) {
+                        seen[vertex].words[i] |= next[vertex].words[i];
+                    }
+                    visit[vertex] = next[vertex];
+                    next[vertex] = Set{};
+                    visitor(first, vertex, level, std::as_const(visit[vertex]), row(vertex));
+                }
+                std::swap(frontier, next_frontier);
+                next_frontier.clear();
+            }
+        }
+    }, 1);
+}
+
+// the same with the results per source: `ShortestPathsCount` for every source, with empty
+// counts unless `PathCounts::KEEP`. writing V distances (and counts) per source costs more
+// than the traversal and does not depend on `Width`, so this takes about the same time at
+// every width; aggregate in the visitor instead to benefit from wider batches.
+template <std::size_t Width = 64, AdjacencyGraph Graph>
+std::vector<ShortestPathsCount> MultiSourceBFS(const Graph& graph, std::span<const std::uint64_t> sources,
+                                               PathCounts path_counts = PathCounts::SKIP,
+                                               std::size_t threads_count = DefaultThreadsCount()) {
+    auto vertices_count = graph.VerticesCount();
+    auto keep_counts = path_counts == PathCounts::KEEP;
+
+    std::vector<ShortestPathsCount> results(sources.size());
+    MultiSourceBFS<Width>(graph, sources, [&](std::size_t first, std::uint64_t vertex, std::uint64_t level,
+                                              const SourceSet<Width>& reached, std::span<const std::uint64_t> counts) {
+        reached.ForEach([&](std::size_t i) {
+            auto& result = results[first + i];
+            if (level == 0) {
+                // every source is reached at level 0 once, by the thread of its batch.
+                result.distances.assign(vertices_count, UNREACHABLE);
+                if (keep_counts) {
+                    result.counts.assign(vertices_count, 0);
+                }
+            }
+            result.distances[vertex] = level;
+            if (keep_counts) {
+                result.counts[vertex] = counts[i];
+            }
+        });
+    }, path_counts, threads_count);
+
+    return results;
+}
+
+}  // namespace graph
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace graph {
+
+[[nodiscard]] inline std::size_t DefaultThreadsCount() {
+    return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// calling `body(thread, block_begin, block_end)` for blocks of at most `grain`
+// items of [begin, end). blocks are handed out dynamically, so skewed work (e.g.
+// hub vertices) is balanced between the `threads_count` workers. `thread` is in
+// [0, threads_count) and can index per-thread state.
+template <typename Body>
+void ParallelFor(std::size_t begin, std::size_t end, std::size_t threads_count, Body&& body,
+                 std::size_t grain = 1024) {
+    if (begin >= end) {
+        return;
+    }
+
+    auto blocks_count = (end - begin + grain - 1) / grain;
+    threads_count = std::clamp<std::size_t>(threads_count, 1, blocks_count);
+    if (threads_count == 1) {
+        body(std::size_t{0}, begin, end);
+        return;
+    }
+
+    std::atomic<std::size_t> next_block = 0;
+    auto worker = [&](std::size_t thread) {
+        for (auto block = next_block.fetch_add(1); block < blocks_count; block = next_block.fetch_add(1)) {
+            auto block_begin = begin + block * grain;
+            body(thread, block_begin, std::min(block_begin + grain, end));
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    workers.reserve(threads_count - 1);
+    for (std::size_t thread = 1; thread < threads_count; ++thread) {
+        workers.emplace_back(worker, thread);
+    }
+    worker(0);
+}
+
+}  // namespace graph
@@ -0,0 +1,163 @@
+#include "paths_count.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <queue>
+
+
+namespace graph {
+
+namespace {
+
+// switching heuristics from Beamer et al., "Direction-Optimizing Breadth-First Search":
+// go bottom-up once the frontier's out-edges exceed 1/ALPHA of the unexplored edges,
+// go back top-down once the frontier shrinks below 1/BETA of the vertices.
+constexpr std::uint64_t ALPHA = 14;
+constexpr std::uint64_t BETA = 24;
+
+std::uint64_t LoadDistance(std::uint64_t& distance) {
+    return std::atomic_ref<std::uint64_t>(distance).load(std::memory_order_relaxed);
+}
+
+// every frontier vertex pushes its count to its unvisited successors. a successor
+// is claimed by the thread winning the cas on its distance, but all threads reaching
+// it on this level add their counts.
+void TopDownStep(const CsrGraph& graph, std::uint64_t level, const std::vector<std::uint64_t>& frontier,
+                 ShortestPathsCount& result, std::vector<std::vector<std::uint64_t>>& next_frontiers,
+                 std::size_t threads_count) {
+    ParallelFor(0, frontier.size(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        auto& next_frontier = next_frontiers[thread];
+        for (auto i = begin; i < end; ++i) {
+            auto vertex = frontier[i];
+            auto count = result.counts[vertex];
+            for (const auto& next_vertex: graph.GetNextVerticesView(vertex)) {
+                std::atomic_ref<std::uint64_t> distance(result.distances[next_vertex]);
+                auto expected = UNREACHABLE;
+                if (distance.compare_exchange_strong(expected, level + 1, std::memory_order_relaxed)) {
+                    next_frontier.push_back(next_vertex);
+                    expected = level + 1;
+                }
+
+                if (expected == level + 1) {
+                    std::atomic_ref<std::uint64_t>(result.counts[next_vertex]).fetch_add(count, std::memory_order_relaxed);
+                }
+            }
+        }
+    }, 64);
+}
+
+// every unvisited vertex pulls counts from its predecessors on the current level.
+// unlike plain bfs it can not stop at the first parent found, since all of them
+// contribute to the count, but it needs no atomic read-modify-writes.
+void BottomUpStep(const CsrGraph& graph, std::uint64_t level, ShortestPathsCount& result,
+                  std::vector<std::vector<std::uint64_t>>& next_frontiers, std::size_t threads_count) {
+    ParallelFor(0, graph.VerticesCount(), threads_count, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+        auto& next_frontier = next_frontiers[thread];
+        for (auto vertex = begin; vertex < end; ++vertex) {
+            if (LoadDistance(result.distances[vertex]) != UNREACHABLE) {
+                continue;
+            }
+
+            bool reached = false;
+            std::uint64_t count = 0;
+            for (const auto& prev_vertex: graph.GetPrevVerticesView(vertex)) {
+                if (LoadDistance(result.distances[prev_vertex]) == level) {
+                    reached = true;
+                    count += result.counts[prev_vertex];
+                }
+            }
+
+            if (reached) {
+                std::atomic_ref<std::uint64_t>(result.distances[vertex]).store(level + 1, std::memory_order_relaxed);
+                result.counts[vertex] = count;
+                next_frontier.push_back(vertex);
+            }
+        }
+    });
+}
+
+}  // namespace
+
+[[nodiscard]] ShortestPathsCount CountShortestPathsSerial(const CsrGraph& graph, std::uint64_t source) {
+    assert(source < graph.VerticesCount());
+
+    ShortestPathsCount result{
+        std::vector<std::uint64_t>(graph.VerticesCount(), UNREACHABLE),
+        std::vector<std::uint64_t>(graph.VerticesCount(), 0),
+    };
+    result.distances[source] = 0;
+    result.counts[source] = 1;
+
+    std::queue<std::uint64_t> queue;
+    queue.push(source);
+    while (!queue.empty()) {
+        auto vertex = queue.front();
+        queue.pop();
+
+        for (const auto& next_vertex: graph.GetNextVerticesView(vertex)) {
+            if (result.distances[next_vertex] == UNREACHABLE) {
+                result.distances[next_vertex] = result.distances[vertex] + 1;
+                queue.push(next_vertex);
+            }
+
+            if (result.distances[next_vertex] == result.distances[vertex] + 1) {
+                result.counts[next_vertex] += result.counts[vertex];
+            }
+        }
+    }
+
+    return result;
+}
+
+[[nodiscard]] ShortestPathsCount CountShortestPaths(const CsrGraph& graph, std::uint64_t source,
+                                                    std::size_t threads_count) {
+    assert(source < graph.VerticesCount());
+    threads_count = std::max<std::size_t>(threads_count, 1);
+
+    ShortestPathsCount result{
+        std::vector<std::uint64_t>(graph.VerticesCount(), UNREACHABLE),
+        std::vector<std::uint64_t>(graph.VerticesCount(), 0),
+    };
+    result.distances[source] = 0;
+    result.counts[source] = 1;
+
+    std::vector<std::uint64_t> frontier{source};
+    std::vector<std::vector<std::uint64_t>> next_frontiers(threads_count);
+
+    std::uint64_t frontier_edges = graph.GetNextVerticesView(source).size();
+    std::uint64_t unexplored_edges = graph.EdgesCount() - frontier_edges;
+    bool bottom_up = false;
+
+    for (std::uint64_t level = 0; !frontier.empty(); ++level) {
+        if (!bottom_up && frontier_edges > unexplored_edges / ALPHA) {
+            bottom_up = true;
+        } else if (bottom_up && frontier.size() < graph.VerticesCount() / BETA) {
+            bottom_up = false;
+        }
+
+        for (auto& next_frontier: next_frontiers) {
+            next_frontier.clear();
+        }
+
+        if (bottom_up) {
+            BottomUpStep(graph, level, result, next_frontiers, threads_count);
+        } else {
+            TopDownStep(graph, level, frontier, result, next_frontiers, threads_count);
+        }
+
+        frontier.clear();
+        frontier_edges = 0;
+        for (const auto& next_frontier: next_frontiers) {
+            for (const auto& vertex: next_frontier) {
+                frontier.push_back(vertex);
+                frontier_edges += graph.GetNextVerticesView(vertex).size();
+            }
+        }
+        unexplored_edges -= frontier_edges;
+    }
+
+    return result;
+}
+
+}  // namespace graph
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace graph {
+
+// bfs distances (in edges) from a source and the number of distinct shortest
+// paths to every vertex. counts are taken modulo 2^64.
+struct ShortestPathsCount {
+    std::vector<std::uint64_t> distances;
+    std::vector<std::uint64_t> counts;
+};
+
+// single-threaded queue-based bfs.
+[[nodiscard]] ShortestPathsCount CountShortestPathsSerial(const CsrGraph& graph, std::uint64_t source);
+
+// level-synchronous bfs that expands each level in parallel and switches between
+// top-down (scanning successors of the frontier) and bottom-up (scanning
+// predecessors of unvisited vertices) steps depending on the frontier size.
+[[nodiscard]] ShortestPathsCount CountShortestPaths(const CsrGraph& graph, std::uint64_t source,
+                                                    std::size_t threads_count = DefaultThreadsCount());
+
+}  // namespace graph
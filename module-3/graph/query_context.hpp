@@ -0,0 +1,84 @@
+#pragma once
+
+#include "base.hpp"
+#include "heaps.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+
+namespace graph {
+
+// scratch state of repeated point-to-point queries: distances, parents, settled flags and the
+// queue, allocated once for `size` vertices. an entry is valid only if its stamp equals the
+// current epoch, so `Begin` starts a new query in O(1) instead of refilling O(V) arrays, and a
+// query costs as much as the vertices it touches. one context per thread, see `DijkstraDistance`.
+template <VertexQueue Queue = IndexedHeap<4>>
+    requires requires(Queue queue) { queue.Clear(); }
+class QueryContext {
+ public:
+    explicit QueryContext(std::size_t size)
+        : distances_(size), parents_(size), reached_(size, 0), settled_(size, 0), queue_(size) {
+    }
+
+    [[nodiscard]] std::size_t VerticesCount() const {
+        return distances_.size();
+    }
+
+    // forgetting the previous query. the queue is cleared in the time of the entries left in it.
+    void Begin() {
+        queue_.Clear();
+        if (++epoch_ == 0) {
+            // once per 2^32 queries the stamps of ancient queries could collide with the new epoch.
+            std::fill(reached_.begin(), reached_.end(), 0);
+            std::fill(settled_.begin(), settled_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    // `UNREACHABLE` for vertices not reached by the current query.
+    [[nodiscard]] std::uint64_t GetDistance(std::uint64_t vertex) const {
+        assert(vertex < VerticesCount());
+        return reached_[vertex] == epoch_ ? distances_[vertex] : UNREACHABLE;
+    }
+
+    // the vertex `vertex` was last reached from, the source is its own parent.
+    [[nodiscard]] std::uint64_t GetParent(std::uint64_t vertex) const {
+        assert(GetDistance(vertex) != UNREACHABLE);
+        return parents_[vertex];
+    }
+
+    void Reach(std::uint64_t vertex, std::uint64_t distance, std::uint64_t parent) {
+        assert(vertex < VerticesCount());
+        reached_[vertex] = epoch_;
+        distances_[vertex] = distance;
+        parents_[vertex] = parent;
+    }
+
+    [[nodiscard]] bool IsSettled(std::uint64_t vertex) const {
+        assert(vertex < VerticesCount());
+        return settled_[vertex] == epoch_;
+    }
+
+    void Settle(std::uint64_t vertex) {
+        assert(vertex < VerticesCount());
+        settled_[vertex] = epoch_;
+    }
+
+    [[nodiscard]] Queue& GetQueue() {
+        return queue_;
+    }
+
+ private:
+    std::vector<std::uint64_t> distances_;
+    std::vector<std::uint64_t> parents_;
+    // epochs in which the entries were last written.
+    std::vector<std::uint32_t> reached_;
+    std::vector<std::uint32_t> settled_;
+    std::uint32_t epoch_ = 0;
+    Queue queue_;
+};
+
+}  // namespace graph
@@ -0,0 +1,124 @@
+#include "reorder.hpp"
+
+#include "csr_graph.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+
+namespace graph {
+
+namespace {
+
+std::vector<std::uint64_t> GetDegrees(const IGraph& graph) {
+    std::vector<std::uint64_t> degrees(graph.VerticesCount(), 0);
+    for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
+        graph.ForEachNextVertex(from, [&degrees, from](std::uint64_t to) {
+            ++degrees[from];
+            ++degrees[to];
+        });
+    }
+
+    return degrees;
+}
+
+Permutation FromOldIds(std::vector<std::uint64_t>&& old_ids) {
+    Permutation permutation{std::vector<std::uint64_t>(old_ids.size()), std::move(old_ids)};
+    for (std::size_t new_id = 0; new_id < permutation.old_ids.size(); ++new_id) {
+        permutation.new_ids[permutation.old_ids[new_id]] = new_id;
+    }
+
+    return permutation;
+}
+
+}  // namespace
+
+[[nodiscard]] Permutation DegreeOrder(const IGraph& graph) {
+    auto degrees = GetDegrees(graph);
+
+    std::vector<std::uint64_t> old_ids(graph.VerticesCount());
+    std::iota(old_ids.begin(), old_ids.end(), 0);
+    std::stable_sort(old_ids.begin(), old_ids.end(), [&degrees](std::uint64_t lhs, std::uint64_t rhs) {
+        return degrees[lhs] > degrees[rhs];
+    });
+
+    return FromOldIds(std::move(old_ids));
+}
+
+[[nodiscard]] Permutation ReverseCuthillMcKeeOrder(const IGraph& graph) {
+    CsrGraph csr(graph);
+    auto degrees = GetDegrees(csr);
+    auto by_degree = [&degrees](std::uint64_t lhs, std::uint64_t rhs) {
+        return degrees[lhs] < degrees[rhs];
+    };
+
+    std::vector<std::uint64_t> starts(csr.VerticesCount());
+    std::iota(starts.begin(), starts.end(), 0);
+    std::stable_sort(starts.begin(), starts.end(), by_degree);
+
+    std::vector<bool> visited(csr.VerticesCount(), false);
+    std::vector<std::uint64_t> old_ids;
+    old_ids.reserve(csr.VerticesCount());
+
+    std::vector<std::uint64_t> neighbours;
+    for (const auto& start: starts) {
+        if (visited[start]) {
+            continue;
+        }
+
+        visited[start] = true;
+        old_ids.push_back(start);
+        for (auto head = old_ids.size() - 1; head < old_ids.size(); ++head) {
+            auto vertex = old_ids[head];
+
+            neighbours.clear();
+            for (const auto& views: {csr.GetNextVerticesView(vertex), csr.GetPrevVerticesView(vertex)}) {
+                for (const auto& neighbour: views) {
+                    if (!visited[neighbour]) {
+                        visited[neighbour] = true;
+                        neighbours.push_back(neighbour);
+                    }
+                }
+            }
+
+            std::stable_sort(neighbours.begin(), neighbours.end(), by_degree);
+            old_ids.insert(old_ids.end(), neighbours.begin(), neighbours.end());
+        }
+    }
+
+    std::reverse(old_ids.begin(), old_ids.end());
+    return FromOldIds(std::move(old_ids));
+}
+
+[[nodiscard]] Permutation HubClusterOrder(const IGraph& graph) {
+    auto degrees = GetDegrees(graph);
+    auto total_degree = std::accumulate(degrees.begin(), degrees.end(), std::uint64_t{0});
+
+    std::vector<std::uint64_t> old_ids(graph.VerticesCount());
+    std::iota(old_ids.begin(), old_ids.end(), 0);
+    std::stable_partition(old_ids.begin(), old_ids.end(), [&](std::uint64_t vertex) {
+        return degrees[vertex] * graph.VerticesCount() > total_degree;
+    });
+
+    return FromOldIds(std::move(old_ids));
+}
+
+[[nodiscard]] std::vector<Edge> RelabelEdges(const IGraph& graph, const Permutation& permutation) {
+    assert(permutation.new_ids.size() == graph.VerticesCount());
+
+    std::vector<Edge> edges;
+    for (std::size_t new_from = 0; new_from < graph.VerticesCount(); ++new_from) {
+        auto first = edges.size();
+        graph.ForEachNextVertex(permutation.old_ids[new_from], [&](std::uint64_t old_to) {
+            edges.emplace_back(new_from, permutation.new_ids[old_to]);
+        });
+        std::sort(edges.begin() + first, edges.end());
+    }
+
+    return edges;
+}
+
+}  // namespace graph
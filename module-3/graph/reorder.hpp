@@ -0,0 +1,60 @@
+#pragma once
+
+#include "base.hpp"
+#include "edge_list.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+
+namespace graph {
+
+// vertex relabeling: `new_ids[old_id]` is the new number of a vertex and
+// `old_ids[new_id]` maps it back.
+struct Permutation {
+    std::vector<std::uint64_t> new_ids;
+    std::vector<std::uint64_t> old_ids;
+};
+
+// vertices by descending total (in + out) degree, ties keep the original order.
+[[nodiscard]] Permutation DegreeOrder(const IGraph& graph);
+
+// reverse Cuthill-McKee: bfs over the undirected graph starting every component
+// from its minimum-degree vertex and visiting neighbours by ascending degree,
+// reversed. it keeps neighbours' ids close to each other.
+[[nodiscard]] Permutation ReverseCuthillMcKeeOrder(const IGraph& graph);
+
+// hub clustering: vertices with above-average degree first, the rest after them,
+// both groups keep the original relative order.
+[[nodiscard]] Permutation HubClusterOrder(const IGraph& graph);
+
+// edges of `graph` in the new numbering, grouped by new source and sorted by new target.
+[[nodiscard]] std::vector<Edge> RelabelEdges(const IGraph& graph, const Permutation& permutation);
+
+// the same graph rebuilt in the new numbering. works for every representation
+// constructible from an edge list, those with an optional reverse index keep it if `graph` has it.
+template <typename Graph>
+[[nodiscard]] Graph Relabel(const Graph& graph, const Permutation& permutation) {
+    auto edges = RelabelEdges(graph, permutation);
+    if constexpr (requires { graph.KeepsReverseEdges(); }) {
+        return Graph(graph.VerticesCount(), edges, graph.KeepsReverseEdges() ? ReverseEdges::KEEP : ReverseEdges::SKIP);
+    } else {
+        return Graph(graph.VerticesCount(), edges);
+    }
+}
+
+// per-vertex values computed on a relabeled graph, reordered back to the original ids.
+template <typename T>
+[[nodiscard]] std::vector<T> RestoreOrder(const std::vector<T>& values, const Permutation& permutation) {
+    assert(values.size() == permutation.old_ids.size());
+
+    std::vector<T> restored(values.size());
+    for (std::size_t new_id = 0; new_id < values.size(); ++new_id) {
+        restored[permutation.old_ids[new_id]] = values[new_id];
+    }
+
+    return restored;
+}
+
+}  // namespace graph
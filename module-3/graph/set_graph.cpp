@@ -6,14 +6,55 @@
 
 namespace graph {
 
-SetGraph::SetGraph(std::size_t size): adjacency_sets_(size) {
+SetGraph::SetGraph(std::size_t size, ReverseEdges reverse_edges)
+    : adjacency_sets_(size), keeps_reverse_edges_(reverse_edges == ReverseEdges::KEEP) {
+    if (keeps_reverse_edges_) {
+        reverse_sets_.resize(size);
+    }
+}
+
+SetGraph::SetGraph(const IGraph& graph, ReverseEdges reverse_edges)
+    : SetGraph(graph.VerticesCount(), reverse_edges) {
+    std::vector<std::size_t> in_degrees(keeps_reverse_edges_ ? VerticesCount() : 0, 0);
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        std::size_t out_degree = 0;
+        graph.ForEachNextVertex(from, [&](std::uint64_t to) {
+            ++out_degree;
+            if (keeps_reverse_edges_) {
+                ++in_degrees[to];
+            }
+        });
+        adjacency_sets_[from].reserve(out_degree);
+    }
+
+    for (std::size_t to = 0; to < in_degrees.size(); ++to) {
+        reverse_sets_[to].reserve(in_degrees[to]);
+    }
+
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        graph.ForEachNextVertex(from, [this, from](std::uint64_t to) {
+            AddEdge(from, to);
+        });
+    }
 }
 
-SetGraph::SetGraph(const IGraph& graph) {
-    for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
-        for (const auto& to: graph.GetNextVertices(from)) {
-            adjacency_sets_[from].insert(to);
-        }
+SetGraph::SetGraph(std::size_t size, std::span<const Edge> edges, ReverseEdges reverse_edges,
+                   std::size_t threads_count)
+    : SetGraph(size, reverse_edges) {
+    auto fill = [size, threads_count](std::vector<std::unordered_set<std::uint64_t>>& sets,
+                                      const AdjacencyArrays& arrays) {
+        ParallelFor(0, size, threads_count, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto vertex = begin; vertex < end; ++vertex) {
+                sets[vertex].reserve(arrays.offsets[vertex + 1] - arrays.offsets[vertex]);
+                sets[vertex].insert(arrays.vertices.begin() + arrays.offsets[vertex],
+                                    arrays.vertices.begin() + arrays.offsets[vertex + 1]);
+            }
+        });
+    };
+
+    fill(adjacency_sets_, GroupBySource(size, edges, threads_count));
+    if (keeps_reverse_edges_) {
+        fill(reverse_sets_, GroupByTarget(size, edges, threads_count));
     }
 }
 
@@ -21,12 +62,19 @@ void SetGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
     assert(from < VerticesCount());
     assert(to < VerticesCount());
     adjacency_sets_[from].insert(to);
+    if (keeps_reverse_edges_) {
+        reverse_sets_[to].insert(from);
+    }
 }
 
 [[nodiscard]] std::size_t SetGraph::VerticesCount() const {
     return adjacency_sets_.size();
 }
 
+[[nodiscard]] bool SetGraph::KeepsReverseEdges() const {
+    return keeps_reverse_edges_;
+}
+
 [[nodiscard]] std::vector<std::uint64_t> SetGraph::GetNextVertices(std::uint64_t vertex) const {
     assert(vertex < VerticesCount());
 
@@ -42,13 +90,19 @@ void SetGraph::AddEdge(std::uint64_t from, std::uint64_t to) {
     assert(vertex < VerticesCount());
 
     std::vector<std::uint64_t> prev_vertices;
-    for (std::size_t from = 0; from < VerticesCount(); ++from) {
-        if (adjacency_sets_[from].contains(vertex)) {
-            prev_vertices.push_back(from);
-        }
-    }
+    ForEachPrevVertex(vertex, [&prev_vertices](std::uint64_t from) {
+        prev_vertices.push_back(from);
+    });
 
     return prev_vertices;
 }
 
+void SetGraph::ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachNextVertex<VertexVisitor&>(vertex, visitor);
+}
+
+void SetGraph::ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const {
+    ForEachPrevVertex<VertexVisitor&>(vertex, visitor);
+}
+
 }  // namespace graph
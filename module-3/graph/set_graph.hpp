@@ -1,8 +1,12 @@
 #pragma once
 
 #include "base.hpp"
+#include "edge_list.hpp"
+#include "parallel.hpp"
 
+#include <cassert>
 #include <cstdint>
+#include <span>
 #include <unordered_set>
 
 
@@ -10,20 +14,65 @@ namespace graph {
 
 class SetGraph: public IGraph {
  public:
-    explicit SetGraph(std::size_t size);
+    explicit SetGraph(std::size_t size, ReverseEdges reverse_edges = ReverseEdges::SKIP);
 
-    explicit SetGraph(const IGraph& graph);
+    explicit SetGraph(const IGraph& graph, ReverseEdges reverse_edges = ReverseEdges::SKIP);
+
+    // bulk construction, every adjacency set is allocated once with its final size.
+    SetGraph(std::size_t size, std::span<const Edge> edges, ReverseEdges reverse_edges = ReverseEdges::SKIP,
+             std::size_t threads_count = DefaultThreadsCount());
 
     void AddEdge(std::uint64_t from, std::uint64_t to) override;
 
     [[nodiscard]] std::size_t VerticesCount() const override;
 
+    [[nodiscard]] bool KeepsReverseEdges() const;
+
     [[nodiscard]] std::vector<std::uint64_t> GetNextVertices(std::uint64_t vertex) const override;
 
     [[nodiscard]] std::vector<std::uint64_t> GetPrevVertices(std::uint64_t vertex) const override;
 
+    void ForEachNextVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    void ForEachPrevVertex(std::uint64_t vertex, VertexVisitor visitor) const override;
+
+    template <typename Visitor>
+    void ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
+    template <typename Visitor>
+    void ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const;
+
  private:
     std::vector<std::unordered_set<std::uint64_t>> adjacency_sets_;
+    // empty unless built with `ReverseEdges::KEEP`.
+    std::vector<std::unordered_set<std::uint64_t>> reverse_sets_;
+    bool keeps_reverse_edges_;
 };
 
+template <typename Visitor>
+void SetGraph::ForEachNextVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+    for (const auto& to: adjacency_sets_[vertex]) {
+        visitor(to);
+    }
+}
+
+template <typename Visitor>
+void SetGraph::ForEachPrevVertex(std::uint64_t vertex, Visitor&& visitor) const {
+    assert(vertex < VerticesCount());
+
+    if (keeps_reverse_edges_) {
+        for (const auto& from: reverse_sets_[vertex]) {
+            visitor(from);
+        }
+        return;
+    }
+
+    for (std::size_t from = 0; from < VerticesCount(); ++from) {
+        if (adjacency_sets_[from].contains(vertex)) {
+            visitor(from);
+        }
+    }
+}
+
 }  // namespace graph
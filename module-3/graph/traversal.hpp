@@ -0,0 +1,493 @@
+#pragma once
+
+#include "base.hpp"
+#include "heaps.hpp"
+#include "query_context.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+
+namespace graph {
+
+// graph enumerating out-neighbours through `ForEachNextVertex`. concrete representations
+// have a template overload of it that is dispatched statically: the visitor is called
+// directly rather than through `VertexVisitor`, so it can be inlined into the loop over
+// neighbours (or the decoding loop of `CompressedGraph`). `IGraph` satisfies the concept
+// through the virtual one and serves as the type-erased fallback.
+template <typename Graph>
+concept AdjacencyGraph = requires(const Graph& graph, std::uint64_t vertex) {
+    { graph.VerticesCount() } -> std::convertible_to<std::size_t>;
+    graph.ForEachNextVertex(vertex, [](std::uint64_t) {});
+};
+
+// graph generating out-edges as `(to, weight)` through `ForEachNextEdge` on the fly, without
+// storing them or knowing the number of vertices, see `ImplicitDijkstraDistance`.
+template <typename Graph>
+concept ImplicitWeightedGraph = requires(const Graph& graph, typename Graph::vertex_t vertex) {
+    typename Graph::weight_t;
+    graph.ForEachNextEdge(vertex, [](typename Graph::vertex_t, typename Graph::weight_t) {});
+};
+
+// graph enumerating out-edges as `(to, weight)` through `ForEachNextEdge`, see `WeightedCsrGraph`.
+template <typename Graph>
+concept WeightedAdjacencyGraph = ImplicitWeightedGraph<Graph> && requires(const Graph& graph) {
+    { graph.VerticesCount() } -> std::convertible_to<std::size_t>;
+};
+
+// traversal hooks doing nothing. visitors derive from it and hide the hooks they need,
+// the calls are resolved at compile time and inlined into the traversal loops.
+struct TraversalVisitor {
+    // `vertex` is reached for the first time (bfs, dfs) or settled with its final distance (dijkstra).
+    void DiscoverVertex(std::uint64_t) {}
+
+    // every edge leaving a discovered vertex.
+    void ExamineEdge(std::uint64_t, std::uint64_t) {}
+
+    // the edge `to` is reached by for the first time (bfs, dfs) or its distance is improved by (dijkstra).
+    void TreeEdge(std::uint64_t, std::uint64_t) {}
+
+    // all edges of `vertex` are examined, for dfs also all of its descendants are finished.
+    void FinishVertex(std::uint64_t) {}
+};
+
+// breadth-first search from `source`, returns hop distances (`UNREACHABLE` for the rest).
+template <AdjacencyGraph Graph, typename Visitor = TraversalVisitor>
+std::vector<std::uint64_t> BFS(const Graph& graph, std::uint64_t source, Visitor&& visitor = {}) {
+    assert(source < graph.VerticesCount());
+
+    std::vector<std::uint64_t> distances(graph.VerticesCount(), UNREACHABLE);
+    // every vertex is pushed once, so a vector with a moving head is enough for a queue.
+    std::vector<std::uint64_t> queue;
+
+    distances[source] = 0;
+    visitor.DiscoverVertex(source);
+    queue.push_back(source);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        auto vertex = queue[head];
+        graph.ForEachNextVertex(vertex, [&](std::uint64_t to) {
+            visitor.ExamineEdge(vertex, to);
+            if (distances[to] == UNREACHABLE) {
+                distances[to] = distances[vertex] + 1;
+                visitor.TreeEdge(vertex, to);
+                visitor.DiscoverVertex(to);
+                queue.push_back(to);
+            }
+        });
+        visitor.FinishVertex(vertex);
+    }
+
+    return distances;
+}
+
+// shortest paths over weights 0 and 1 with a deque instead of a priority queue: a 0-edge
+// puts its target to the front and a 1-edge to the back, so the deque always holds one or
+// two consecutive distances in order. O(V + E), a vertex may be pushed twice.
+template <WeightedAdjacencyGraph Graph, typename Visitor = TraversalVisitor>
+std::vector<std::uint64_t> ZeroOneBFS(const Graph& graph, std::uint64_t source, Visitor&& visitor = {}) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+    assert(source < graph.VerticesCount());
+
+    std::vector<std::uint64_t> distances(graph.VerticesCount(), UNREACHABLE);
+    std::vector<bool> settled(graph.VerticesCount(), false);
+    std::deque<std::uint64_t> queue;
+
+    distances[source] = 0;
+    queue.push_back(source);
+    while (!queue.empty()) {
+        auto vertex = queue.front();
+        queue.pop_front();
+        if (settled[vertex]) {
+            continue;
+        }
+
+        settled[vertex] = true;
+        visitor.DiscoverVertex(vertex);
+        graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t to, weight_t weight) {
+            assert(weight <= 1);
+            visitor.ExamineEdge(vertex, to);
+            auto next_distance = distances[vertex] + weight;
+            if (next_distance < distances[to]) {
+                distances[to] = next_distance;
+                visitor.TreeEdge(vertex, to);
+                if (weight == 0) {
+                    queue.push_front(to);
+                } else {
+                    queue.push_back(to);
+                }
+            }
+        });
+        visitor.FinishVertex(vertex);
+    }
+
+    return distances;
+}
+
+// iterative depth-first search from `source`. neighbours are visited in the reverse of
+// the `ForEachNextVertex` order, since they are pushed onto the stack in that order.
+template <AdjacencyGraph Graph, typename Visitor = TraversalVisitor>
+void DFS(const Graph& graph, std::uint64_t source, Visitor&& visitor = {}) {
+    assert(source < graph.VerticesCount());
+
+    struct Frame {
+        std::uint64_t vertex;
+        std::uint64_t parent;
+        bool finishing;
+    };
+
+    std::vector<bool> discovered(graph.VerticesCount(), false);
+    std::vector<Frame> stack{{source, source, false}};
+    while (!stack.empty()) {
+        auto frame = stack.back();
+        stack.pop_back();
+
+        if (frame.finishing) {
+            visitor.FinishVertex(frame.vertex);
+            continue;
+        }
+        if (discovered[frame.vertex]) {
+            continue;
+        }
+
+        discovered[frame.vertex] = true;
+        if (frame.vertex != source) {
+            visitor.TreeEdge(frame.parent, frame.vertex);
+        }
+        visitor.DiscoverVertex(frame.vertex);
+
+        stack.push_back({frame.vertex, frame.parent, true});
+        graph.ForEachNextVertex(frame.vertex, [&](std::uint64_t to) {
+            visitor.ExamineEdge(frame.vertex, to);
+            if (!discovered[to]) {
+                stack.push_back({to, frame.vertex, false});
+            }
+        });
+    }
+}
+
+// weighted graph that also enumerates in-edges as `(from, weight)` through `ForEachPrevEdge`,
+// e.g. `WeightedCsrGraph` built with `ReverseEdges::KEEP`.
+template <typename Graph>
+concept BidirectionalWeightedGraph = WeightedAdjacencyGraph<Graph>
+                                     && requires(const Graph& graph, typename Graph::vertex_t vertex) {
+    graph.ForEachPrevEdge(vertex, [](typename Graph::vertex_t, typename Graph::weight_t) {});
+};
+
+namespace detail {
+
+// dijkstra settling vertices until `target` is settled or the queue runs out.
+template <typename Queue, typename Graph, typename Visitor>
+std::vector<std::uint64_t> RunDijkstra(const Graph& graph, std::uint64_t source, std::uint64_t target,
+                                       Visitor& visitor) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+    assert(source < graph.VerticesCount());
+
+    std::vector<std::uint64_t> distances(graph.VerticesCount(), UNREACHABLE);
+    Queue queue(graph.VerticesCount());
+
+    distances[source] = 0;
+    queue.Push(source, 0);
+    while (!queue.Empty()) {
+        auto [distance, vertex] = queue.Pop();
+        if (distance != distances[vertex]) {
+            continue;
+        }
+
+        visitor.DiscoverVertex(vertex);
+        if (vertex == target) {
+            break;
+        }
+
+        graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t to, weight_t weight) {
+            visitor.ExamineEdge(vertex, to);
+            auto next_distance = distance + weight;
+            if (next_distance < distances[to]) {
+                distances[to] = next_distance;
+                visitor.TreeEdge(vertex, to);
+                queue.Push(to, next_distance);
+            }
+        });
+        visitor.FinishVertex(vertex);
+    }
+
+    return distances;
+}
+
+}  // namespace detail
+
+// dijkstra from `source` over non-negative weights, returns distances (`UNREACHABLE` for
+// vertices not reached). the priority queue is pluggable, see `VertexQueue`: the default
+// indexed 4-ary heap decreases keys in place, `RadixHeap` is faster for integer weights and
+// `BucketQueue` for small ones (see also `ZeroOneBFS` for weights 0 and 1).
+template <VertexQueue Queue = IndexedHeap<4>, WeightedAdjacencyGraph Graph, typename Visitor = TraversalVisitor>
+std::vector<std::uint64_t> Dijkstra(const Graph& graph, std::uint64_t source, Visitor&& visitor = {}) {
+    return detail::RunDijkstra<Queue>(graph, source, UNREACHABLE, visitor);
+}
+
+// point-to-point dijkstra stopping as soon as `to` is settled, returns `UNREACHABLE` if there is
+// no path. the search state lives in `context`, so repeated queries allocate nothing and cost
+// only what they explore. the context keeps distances and parents until the next query.
+template <VertexQueue Queue, WeightedAdjacencyGraph Graph, typename Visitor = TraversalVisitor>
+std::uint64_t DijkstraDistance(const Graph& graph, std::uint64_t from, std::uint64_t to,
+                               QueryContext<Queue>& context, Visitor&& visitor = {}) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+    assert(from < graph.VerticesCount());
+    assert(to < graph.VerticesCount());
+    assert(context.VerticesCount() >= graph.VerticesCount());
+
+    context.Begin();
+    auto& queue = context.GetQueue();
+    context.Reach(from, 0, from);
+    queue.Push(from, 0);
+    while (!queue.Empty()) {
+        auto [distance, vertex] = queue.Pop();
+        if (context.IsSettled(vertex)) {
+            continue;
+        }
+
+        context.Settle(vertex);
+        visitor.DiscoverVertex(vertex);
+        if (vertex == to) {
+            return distance;
+        }
+
+        graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t next, weight_t weight) {
+            visitor.ExamineEdge(vertex, next);
+            auto next_distance = distance + weight;
+            if (next_distance < context.GetDistance(next)) {
+                context.Reach(next, next_distance, vertex);
+                visitor.TreeEdge(vertex, next);
+                queue.Push(next, next_distance);
+            }
+        });
+        visitor.FinishVertex(vertex);
+    }
+
+    return UNREACHABLE;
+}
+
+// the same with a context allocated for one query.
+template <VertexQueue Queue = IndexedHeap<4>, WeightedAdjacencyGraph Graph, typename Visitor = TraversalVisitor>
+std::uint64_t DijkstraDistance(const Graph& graph, std::uint64_t from, std::uint64_t to, Visitor&& visitor = {}) {
+    QueryContext<Queue> context(graph.VerticesCount());
+    return DijkstraDistance(graph, from, to, context, visitor);
+}
+
+// point-to-point dijkstra on an implicit graph: distances are kept in a hash map, so memory
+// grows with the explored region rather than with the vertex ids, and the search stops once
+// `to` is settled. the queue must not be indexed by vertex, `RadixHeap` or `LazyHeap`.
+template <VertexQueue Queue = RadixHeap, ImplicitWeightedGraph Graph, typename Visitor = TraversalVisitor>
+std::uint64_t ImplicitDijkstraDistance(const Graph& graph, std::uint64_t from, std::uint64_t to,
+                                       Visitor&& visitor = {}) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+
+    std::unordered_map<std::uint64_t, std::uint64_t> distances;
+    Queue queue(0);
+
+    distances[from] = 0;
+    queue.Push(from, 0);
+    while (!queue.Empty()) {
+        auto [distance, vertex] = queue.Pop();
+        if (distance != distances[vertex]) {
+            continue;
+        }
+
+        visitor.DiscoverVertex(vertex);
+        if (vertex == to) {
+            return distance;
+        }
+
+        graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t next, weight_t weight) {
+            visitor.ExamineEdge(vertex, next);
+            auto next_distance = distance + weight;
+            auto [it, inserted] = distances.try_emplace(next, next_distance);
+            if (inserted || next_distance < it->second) {
+                it->second = next_distance;
+                visitor.TreeEdge(vertex, next);
+                queue.Push(next, next_distance);
+            }
+        });
+        visitor.FinishVertex(vertex);
+    }
+
+    return UNREACHABLE;
+}
+
+// bidirectional point-to-point dijkstra: a forward search from `from` over out-edges and a
+// backward one from `to` over in-edges, advancing the side with the smaller radius. `best` is
+// the shortest path found through an edge joining the two searches, and the search stops once
+// the radii sum up to it: any shorter path would have a vertex inside both balls. on road
+// networks the two balls hold far fewer vertices than one ball of the full radius.
+//
+// `forward` and `backward` hold the state of the two searches, see `QueryContext`.
+template <VertexQueue Queue, BidirectionalWeightedGraph Graph, typename Visitor = TraversalVisitor>
+std::uint64_t BidirectionalDijkstraDistance(const Graph& graph, std::uint64_t from, std::uint64_t to,
+                                            QueryContext<Queue>& forward, QueryContext<Queue>& backward,
+                                            Visitor&& visitor = {}) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+    assert(from < graph.VerticesCount());
+    assert(to < graph.VerticesCount());
+    assert(forward.VerticesCount() >= graph.VerticesCount());
+    assert(backward.VerticesCount() >= graph.VerticesCount());
+
+    if (from == to) {
+        return 0;
+    }
+
+    std::array<QueryContext<Queue>*, 2> searches{&forward, &backward};
+    // the last settled distances, every vertex left in a queue is at least that far.
+    std::array<std::uint64_t, 2> radii{0, 0};
+    forward.Begin();
+    forward.Reach(from, 0, from);
+    forward.GetQueue().Push(from, 0);
+    backward.Begin();
+    backward.Reach(to, 0, to);
+    backward.GetQueue().Push(to, 0);
+
+    auto best = UNREACHABLE;
+    while (!forward.GetQueue().Empty() && !backward.GetQueue().Empty()) {
+        auto side = radii[0] <= radii[1] ? 0 : 1;
+        auto& search = *searches[side];
+        const auto& other = *searches[1 - side];
+
+        auto [distance, vertex] = search.GetQueue().Pop();
+        if (search.IsSettled(vertex)) {
+            continue;
+        }
+
+        search.Settle(vertex);
+        radii[side] = distance;
+        if (distance + radii[1 - side] >= best) {
+            break;
+        }
+
+        visitor.DiscoverVertex(vertex);
+        auto relax = [&](vertex_t next, weight_t weight) {
+            visitor.ExamineEdge(vertex, next);
+            auto next_distance = distance + weight;
+            if (next_distance < search.GetDistance(next)) {
+                search.Reach(next, next_distance, vertex);
+                visitor.TreeEdge(vertex, next);
+                search.GetQueue().Push(next, next_distance);
+            }
+            if (other.GetDistance(next) != UNREACHABLE) {
+                best = std::min(best, next_distance + other.GetDistance(next));
+            }
+        };
+        if (side == 0) {
+            graph.ForEachNextEdge(static_cast<vertex_t>(vertex), relax);
+        } else {
+            graph.ForEachPrevEdge(static_cast<vertex_t>(vertex), relax);
+        }
+        visitor.FinishVertex(vertex);
+    }
+
+    return best;
+}
+
+// the same with contexts allocated for one query.
+template <VertexQueue Queue = IndexedHeap<4>, BidirectionalWeightedGraph Graph, typename Visitor = TraversalVisitor>
+std::uint64_t BidirectionalDijkstraDistance(const Graph& graph, std::uint64_t from, std::uint64_t to,
+                                            Visitor&& visitor = {}) {
+    QueryContext<Queue> forward(graph.VerticesCount());
+    QueryContext<Queue> backward(graph.VerticesCount());
+    return BidirectionalDijkstraDistance(graph, from, to, forward, backward, visitor);
+}
+
+// A* from `from` to `to`: dijkstra ordered by `distance + potential(vertex)`, where `potential`
+// is a lower bound of the distance from a vertex to `to` (`UNREACHABLE` when `to` can not be
+// reached from it, such vertices are pruned). the bound must be consistent, i.e. never drop by
+// more than the weight of an edge, which keeps the keys monotone for `RadixHeap` as well.
+template <VertexQueue Queue = IndexedHeap<4>, WeightedAdjacencyGraph Graph, typename Potential,
+          typename Visitor = TraversalVisitor>
+std::uint64_t AStarDistance(const Graph& graph, std::uint64_t from, std::uint64_t to, Potential&& potential,
+                            Visitor&& visitor = {}) {
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+    assert(from < graph.VerticesCount());
+    assert(to < graph.VerticesCount());
+
+    std::vector<std::uint64_t> distances(graph.VerticesCount(), UNREACHABLE);
+    // potentials are computed once per vertex, `UNREACHABLE` marks the ones not computed yet.
+    std::vector<std::uint64_t> potentials(graph.VerticesCount(), UNREACHABLE);
+    auto get_potential = [&](std::uint64_t vertex) {
+        if (potentials[vertex] == UNREACHABLE) {
+            potentials[vertex] = potential(vertex);
+        }
+        return potentials[vertex];
+    };
+
+    Queue queue(graph.VerticesCount());
+    if (get_potential(from) == UNREACHABLE) {
+        return UNREACHABLE;
+    }
+
+    distances[from] = 0;
+    queue.Push(from, get_potential(from));
+    while (!queue.Empty()) {
+        auto [key, vertex] = queue.Pop();
+        auto distance = distances[vertex];
+        if (key != distance + potentials[vertex]) {
+            continue;
+        }
+
+        visitor.DiscoverVertex(vertex);
+        if (vertex == to) {
+            return distance;
+        }
+
+        graph.ForEachNextEdge(static_cast<vertex_t>(vertex), [&](vertex_t next, weight_t weight) {
+            visitor.ExamineEdge(vertex, next);
+            auto next_distance = distance + weight;
+            if (next_distance < distances[next] && get_potential(next) != UNREACHABLE) {
+                distances[next] = next_distance;
+                visitor.TreeEdge(vertex, next);
+                queue.Push(next, next_distance + potentials[next]);
+            }
+        });
+        visitor.FinishVertex(vertex);
+    }
+
+    return UNREACHABLE;
+}
+
+// `graph` with every edge reversed, a view that does not copy it.
+template <BidirectionalWeightedGraph Graph>
+class ReversedGraph {
+ public:
+    using vertex_t = typename Graph::vertex_t;
+    using weight_t = typename Graph::weight_t;
+
+    explicit ReversedGraph(const Graph& graph): graph_(graph) {
+    }
+
+    [[nodiscard]] std::size_t VerticesCount() const {
+        return graph_.VerticesCount();
+    }
+
+    template <typename Visitor>
+    void ForEachNextEdge(vertex_t vertex, Visitor&& visitor) const {
+        graph_.ForEachPrevEdge(vertex, visitor);
+    }
+
+    template <typename Visitor>
+    void ForEachPrevEdge(vertex_t vertex, Visitor&& visitor) const {
+        graph_.ForEachNextEdge(vertex, visitor);
+    }
+
+ private:
+    const Graph& graph_;
+};
+
+}  // namespace graph
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "base.hpp"
+#include "edge_list.hpp"
+#include "parallel.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace graph {
+
+// read-only weighted compressed sparse row graph generic over the widths of
+// vertex ids and weights. targets and weights live in separate arrays indexed by
+// the same offsets, so a traversal streams 4 + 4 bytes per edge with the default
+// types and a weight-free one streams only the targets.
+template <typename Vertex = std::uint32_t, typename Weight = std::uint32_t>
+class WeightedCsrGraph {
+ public:
+    using vertex_t = Vertex;
+    using weight_t = Weight;
+    using Edge = BasicWeightedEdge<Vertex, Weight>;
+
+    // built in parallel, see `GroupBySource`.
+    WeightedCsrGraph(std::size_t size, std::span<const Edge> edges, ReverseEdges reverse_edges = ReverseEdges::SKIP,
+                     std::size_t threads_count = DefaultThreadsCount())
+        : next_(GroupBySource<Vertex, Weight>(size, edges, threads_count)) {
+        assert(size == 0 || size - 1 <= std::size_t{std::numeric_limits<Vertex>::max()});
+        if (reverse_edges == ReverseEdges::KEEP) {
+            prev_ = GroupByTarget<Vertex, Weight>(size, edges, threads_count);
+        }
+    }
+
+    // conversion from any weighted graph with `ForEachNextEdge(vertex, visitor(to, weight))`.
+    template <typename Graph>
+        requires requires(const Graph& graph, Vertex vertex) {
+            graph.ForEachNextEdge(vertex, [](Vertex, Weight) {});
+        }
+    explicit WeightedCsrGraph(const Graph& graph, ReverseEdges reverse_edges = ReverseEdges::SKIP)
+        : WeightedCsrGraph(graph.VerticesCount(), CollectEdges(graph), reverse_edges) {
+    }
+
+    [[nodiscard]] std::size_t VerticesCount() const {
+        return next_.offsets.size() - 1;
+    }
+
+    [[nodiscard]] std::size_t EdgesCount() const {
+        return next_.vertices.size();
+    }
+
+    [[nodiscard]] bool KeepsReverseEdges() const {
+        return !prev_.offsets.empty();
+    }
+
+    [[nodiscard]] std::span<const Vertex> GetNextVertices(Vertex vertex) const {
+        return Slice(next_.vertices, next_, vertex);
+    }
+
+    // weights of the edges from `GetNextVertices`, in the same order.
+    [[nodiscard]] std::span<const Weight> GetNextWeights(Vertex vertex) const {
+        return Slice(next_.weights, next_, vertex);
+    }
+
+    // only with `ReverseEdges::KEEP`.
+    [[nodiscard]] std::span<const Vertex> GetPrevVertices(Vertex vertex) const {
+        assert(KeepsReverseEdges());
+        return Slice(prev_.vertices, prev_, vertex);
+    }
+
+    [[nodiscard]] std::span<const Weight> GetPrevWeights(Vertex vertex) const {
+        assert(KeepsReverseEdges());
+        return Slice(prev_.weights, prev_, vertex);
+    }
+
+    // calls `visitor(to)` for every outgoing edge, which makes the graph usable by `BFS` and `DFS`.
+    template <typename Visitor>
+    void ForEachNextVertex(Vertex vertex, Visitor&& visitor) const {
+        for (const auto& to: GetNextVertices(vertex)) {
+            visitor(to);
+        }
+    }
+
+    // calls `visitor(to, weight)` for every outgoing edge.
+    template <typename Visitor>
+    void ForEachNextEdge(Vertex vertex, Visitor&& visitor) const {
+        ForEachEdge(next_, vertex, visitor);
+    }
+
+    // calls `visitor(from, weight)` for every incoming edge, only with `ReverseEdges::KEEP`.
+    template <typename Visitor>
+    void ForEachPrevEdge(Vertex vertex, Visitor&& visitor) const {
+        assert(KeepsReverseEdges());
+        ForEachEdge(prev_, vertex, visitor);
+    }
+
+ private:
+    using Arrays = BasicAdjacencyArrays<Vertex, Weight>;
+
+    template <typename Graph>
+    static std::vector<Edge> CollectEdges(const Graph& graph) {
+        std::vector<Edge> edges;
+        for (std::size_t from = 0; from < graph.VerticesCount(); ++from) {
+            graph.ForEachNextEdge(static_cast<Vertex>(from), [&edges, from](Vertex to, Weight weight) {
+                edges.push_back(Edge{static_cast<Vertex>(from), to, weight});
+            });
+        }
+
+        return edges;
+    }
+
+    template <typename T>
+    static std::span<const T> Slice(const std::vector<T>& values, const Arrays& arrays, Vertex vertex) {
+        assert(vertex + std::size_t{1} < arrays.offsets.size());
+        return std::span<const T>(values.data() + arrays.offsets[vertex], values.data() + arrays.offsets[vertex + 1]);
+    }
+
+    template <typename Visitor>
+    static void ForEachEdge(const Arrays& arrays, Vertex vertex, Visitor& visitor) {
+        assert(vertex + std::size_t{1} < arrays.offsets.size());
+        for (auto i = arrays.offsets[vertex]; i < arrays.offsets[vertex + 1]; ++i) {
+            visitor(arrays.vertices[i], arrays.weights[i]);
+        }
+    }
+
+    Arrays next_;
+    // empty unless built with `ReverseEdges::KEEP`.
+    Arrays prev_;
+};
+
+}  // namespace graph
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "base.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace graph {
+
+// weighted adjacency lists generic over the widths of vertex ids and weights.
+// every list is stored as two parallel arrays (targets and weights), so with the
+// default 32-bit types an edge takes 8 bytes instead of 16 and a traversal that
+// only needs targets never touches the weights.
+template <typename Vertex = std::uint32_t, typename Weight = std::uint32_t>
+class WeightedListGraph {
+ public:
+    using vertex_t = Vertex;
+    using weight_t = Weight;
+
+    explicit WeightedListGraph(std::size_t size, ReverseEdges reverse_edges = ReverseEdges::SKIP)
+        : next_lists_(size), keeps_reverse_edges_(reverse_edges == ReverseEdges::KEEP) {
+        if (keeps_reverse_edges_) {
+            prev_lists_.resize(size);
+        }
+    }
+
+    void AddEdge(Vertex from, Vertex to, Weight weight) {
+        assert(from < VerticesCount());
+        assert(to < VerticesCount());
+
+        next_lists_[from].vertices.push_back(to);
+        next_lists_[from].weights.push_back(weight);
+        if (keeps_reverse_edges_) {
+            prev_lists_[to].vertices.push_back(from);
+            prev_lists_[to].weights.push_back(weight);
+        }
+    }
+
+    [[nodiscard]] std::size_t VerticesCount() const {
+        return next_lists_.size();
+    }
+
+    [[nodiscard]] bool KeepsReverseEdges() const {
+        return keeps_reverse_edges_;
+    }
+
+    [[nodiscard]] std::span<const Vertex> GetNextVertices(Vertex vertex) const {
+        assert(vertex < VerticesCount());
+        return next_lists_[vertex].vertices;
+    }
+
+    // weights of the edges from `GetNextVertices`, in the same order.
+    [[nodiscard]] std::span<const Weight> GetNextWeights(Vertex vertex) const {
+        assert(vertex < VerticesCount());
+        return next_lists_[vertex].weights;
+    }
+
+    // only with `ReverseEdges::KEEP`.
+    [[nodiscard]] std::span<const Vertex> GetPrevVertices(Vertex vertex) const {
+        assert(keeps_reverse_edges_ && vertex < VerticesCount());
+        return prev_lists_[vertex].vertices;
+    }
+
+    [[nodiscard]] std::span<const Weight> GetPrevWeights(Vertex vertex) const {
+        assert(keeps_reverse_edges_ && vertex < VerticesCount());
+        return prev_lists_[vertex].weights;
+    }
+
+    // calls `visitor(to)` for every outgoing edge, which makes the graph usable by `BFS` and `DFS`.
+    template <typename Visitor>
+    void ForEachNextVertex(Vertex vertex, Visitor&& visitor) const {
+        assert(vertex < VerticesCount());
+        for (const auto& to: next_lists_[vertex].vertices) {
+            visitor(to);
+        }
+    }
+
+    // calls `visitor(to, weight)` for every outgoing edge.
+    template <typename Visitor>
+    void ForEachNextEdge(Vertex vertex, Visitor&& visitor) const {
+        assert(vertex < VerticesCount());
+        ForEachEdge(next_lists_[vertex], visitor);
+    }
+
+    // calls `visitor(from, weight)` for every incoming edge, O(E) without `ReverseEdges::KEEP`.
+    template <typename Visitor>
+    void ForEachPrevEdge(Vertex vertex, Visitor&& visitor) const {
+        assert(vertex < VerticesCount());
+
+        if (keeps_reverse_edges_) {
+            ForEachEdge(prev_lists_[vertex], visitor);
+            return;
+        }
+
+        for (std::size_t from = 0; from < VerticesCount(); ++from) {
+            const auto& list = next_lists_[from];
+            for (std::size_t i = 0; i < list.vertices.size(); ++i) {
+                if (list.vertices[i] == vertex) {
+                    visitor(static_cast<Vertex>(from), list.weights[i]);
+                }
+            }
+        }
+    }
+
+ private:
+    struct EdgeList {
+        std::vector<Vertex> vertices;
+        std::vector<Weight> weights;
+    };
+
+    template <typename Visitor>
+    static void ForEachEdge(const EdgeList& list, Visitor& visitor) {
+        for (std::size_t i = 0; i < list.vertices.size(); ++i) {
+            visitor(list.vertices[i], list.weights[i]);
+        }
+    }
+
+    std::vector<EdgeList> next_lists_;
+    // empty unless built with `ReverseEdges::KEEP`.
+    std::vector<EdgeList> prev_lists_;
+    bool keeps_reverse_edges_;
+};
+
+}  // namespace graph
@@ -40,7 +40,7 @@ struct IGraph {
 
     [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
 
-    [[nodiscard]] virtual std::vector<Edge> GetNextEdges(vertex_t vertex) const = 0;
+    [[nodiscard]] virtual const std::vector<Edge>& GetNextEdges(vertex_t vertex) const = 0;
     [[nodiscard]] virtual std::vector<Edge> GetPrevEdges(vertex_t vertex) const = 0; 
 };
 
@@ -66,7 +66,7 @@ class ListGraph: public IGraph {
         return adjacency_lists_.size();
     }
 
-    [[nodiscard]] std::vector<Edge> GetNextEdges(vertex_t vertex) const override {
+    [[nodiscard]] const std::vector<Edge>& GetNextEdges(vertex_t vertex) const override {
         assert(vertex < VerticesCount());
         return adjacency_lists_[vertex];
     }
@@ -100,7 +100,7 @@ void DFS(const IGraph& graph, vertex_t start, std::vector<bool>& visited) {
         stack.pop();
 
         visited[vertex] = true;
-        for (const auto edge: graph.GetNextEdges(vertex)) {
+        for (const auto& edge: graph.GetNextEdges(vertex)) {
             if (!visited[edge.to]) {
                 stack.push(edge.to);
             }
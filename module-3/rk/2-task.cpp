@@ -43,7 +43,7 @@ struct IGraph {
 
     [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
 
-    [[nodiscard]] virtual std::vector<Edge> GetNextEdges(vertex_t vertex) const = 0;
+    [[nodiscard]] virtual const std::vector<Edge>& GetNextEdges(vertex_t vertex) const = 0;
     [[nodiscard]] virtual std::vector<Edge> GetPrevEdges(vertex_t vertex) const = 0; 
 
     [[nodiscard]] bool HasEdge(vertex_t from, vertex_t to) const {
@@ -79,7 +79,7 @@ class ListGraph: public IGraph {
         return adjacency_lists_.size();
     }
 
-    [[nodiscard]] std::vector<Edge> GetNextEdges(vertex_t vertex) const override {
+    [[nodiscard]] const std::vector<Edge>& GetNextEdges(vertex_t vertex) const override {
         assert(vertex < VerticesCount());
         return adjacency_lists_[vertex];
     }
@@ -24,105 +24,120 @@
 #include <utility>
 #include <limits>
 #include <vector>
-#include <set>
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <concepts>
+#include <unordered_map>
 
 // #define DEBUG
 
 
 using vertex_t = std::uint64_t;
 
-struct Edge {
-    vertex_t from;
-    vertex_t to;
-    std::size_t weight;
+// graph generating out-edges as `(to, weight)` on the fly instead of storing them,
+// with a known bound on the weights.
+template <typename Graph>
+concept ImplicitGraph = requires(const Graph& graph, vertex_t vertex) {
+    { graph.MaxWeight() } -> std::convertible_to<std::size_t>;
+    graph.ForEachNextEdge(vertex, [](vertex_t, std::size_t) {});
 };
 
-bool operator < (const Edge& lhs, const Edge& rhs) {
-    return lhs.weight < rhs.weight;
-}
-
-struct IGraph {
-    virtual ~IGraph() {}
-
-    virtual void AddEdge(vertex_t from, vertex_t to, std::size_t weight) = 0;
-
-    [[nodiscard]] virtual std::size_t VerticesCount() const  = 0;
-
-    [[nodiscard]] virtual const std::vector<Edge>& GetNextEdges(vertex_t vertex) const = 0;
-    [[nodiscard]] virtual std::vector<Edge> GetPrevEdges(vertex_t vertex) const = 0; 
-};
-
-class ListGraph: public IGraph {
+// universe `z` leads to `(z + 1) mod M` for `a` bottles and to `(z^2 + 1) mod M` for `b`.
+class TeleportGraph {
  public:
-    explicit ListGraph(std::size_t size): adjacency_lists_(size) {
+    TeleportGraph(std::size_t universe_count, std::size_t a_weight, std::size_t b_weight)
+        : universe_count_(universe_count), a_weight_(a_weight), b_weight_(b_weight) {
     }
 
-    explicit ListGraph(const IGraph& graph): adjacency_lists_(graph.VerticesCount()) {
-        for (vertex_t from = 0; from < graph.VerticesCount(); ++from) {
-            adjacency_lists_[from] = graph.GetNextEdges(from);
-        }
+    [[nodiscard]] std::size_t MaxWeight() const {
+        return std::max(a_weight_, b_weight_);
     }
 
-    void AddEdge(vertex_t from, vertex_t to, std::size_t weight) override {
-        assert(from < VerticesCount());
-        assert(to < VerticesCount());
-
-        adjacency_lists_[from].push_back(Edge{from, to, weight});
+    template <typename Visitor>
+    void ForEachNextEdge(vertex_t universe, Visitor&& visitor) const {
+        assert(universe < universe_count_);
+        visitor((universe + 1) % universe_count_, a_weight_);
+        visitor((universe * universe + 1) % universe_count_, b_weight_);
     }
 
-    [[nodiscard]] std::size_t VerticesCount() const override {
-        return adjacency_lists_.size();
+ private:
+    std::size_t universe_count_;
+    std::size_t a_weight_;
+    std::size_t b_weight_;
+};
+
+
+// dial's bucket queue: weights are at most 100, so keys in the queue lie within
+// `max_weight` of the last popped one and fit a ring of `max_weight + 1` buckets indexed
+// by `key mod size`. with weights 0 and 1 the ring has two buckets and works like the
+// deque of 0-1 bfs. buckets keep their capacity, so pushes stop allocating after warm-up.
+class BucketQueue {
+ public:
+    explicit BucketQueue(std::size_t max_weight): buckets_(max_weight + 1) {
     }
 
-    [[nodiscard]] const std::vector<Edge>& GetNextEdges(vertex_t vertex) const override {
-        assert(vertex < VerticesCount());
-        return adjacency_lists_[vertex];
+    [[nodiscard]] bool Empty() const {
+        return size_ == 0;
     }
 
-    [[nodiscard]] std::vector<Edge> GetPrevEdges(vertex_t vertex) const override {
-        assert(vertex < VerticesCount());
+    void Push(vertex_t vertex, std::size_t key) {
+        assert(key >= cursor_ && key - cursor_ < buckets_.size());
+        buckets_[key % buckets_.size()].push_back(vertex);
+        ++size_;
+    }
 
-        std::vector<Edge> prev_vertices;
-        for (vertex_t from = 0; from < VerticesCount(); ++from) {
-            for (const auto& edge: adjacency_lists_[from]) {
-                if (edge.to == vertex) {
-                    prev_vertices.push_back(edge);
-                }
-            }
+    // the entry with the minimum key as `{key, vertex}`.
+    std::pair<std::size_t, vertex_t> Pop() {
+        while (buckets_[cursor_ % buckets_.size()].empty()) {
+            ++cursor_;
         }
 
-        return prev_vertices;
+        auto& bucket = buckets_[cursor_ % buckets_.size()];
+        auto vertex = bucket.back();
+        bucket.pop_back();
+        --size_;
+        return {cursor_, vertex};
     }
 
  private:
-    std::vector<std::vector<Edge>> adjacency_lists_;
+    std::vector<std::vector<vertex_t>> buckets_;
+    std::size_t cursor_ = 0;
+    std::size_t size_ = 0;
 };
 
 
-std::size_t FindShortestPath(const IGraph& graph, vertex_t from, vertex_t to) {
-    std::vector<std::size_t> distances(graph.VerticesCount(), std::numeric_limits<std::size_t>::max());
-    std::set<std::pair<std::size_t, vertex_t>> queue;
+// dijkstra stopping once `to` is settled. distances live in a hash map, so memory and setup
+// are proportional to the explored region rather than to the number of universes, and there
+// is no O(M) state a reusable query context would save.
+template <ImplicitGraph Graph>
+std::size_t FindShortestPath(const Graph& graph, vertex_t from, vertex_t to) {
+    std::unordered_map<vertex_t, std::size_t> distances;
+    BucketQueue queue(graph.MaxWeight());
 
     distances[from] = 0;
-    queue.insert({0, from});
+    queue.Push(from, 0);
 
-    while (!queue.empty()) {
-        auto prev_edge = *queue.begin();
-        queue.erase(queue.begin());
+    while (!queue.Empty()) {
+        auto [distance, curr_vertex] = queue.Pop();
+        if (distance != distances[curr_vertex]) {
+            continue;
+        }
+        if (curr_vertex == to) {
+            return distance;
+        }
 
-        auto curr_vertex = prev_edge.second;
-        for (const auto& next_edge: graph.GetNextEdges(curr_vertex)) {
-            if (distances[curr_vertex] + next_edge.weight < distances[next_edge.to]) {
-                distances[next_edge.to] = distances[curr_vertex] + next_edge.weight;
-                queue.insert({distances[next_edge.to], next_edge.to});
+        graph.ForEachNextEdge(curr_vertex, [&](vertex_t next_vertex, std::size_t weight) {
+            auto [it, inserted] = distances.try_emplace(next_vertex, distance + weight);
+            if (inserted || distance + weight < it->second) {
+                it->second = distance + weight;
+                queue.Push(next_vertex, distance + weight);
             }
-        }
+        });
     }
 
-    assert(distances[to] != std::numeric_limits<std::size_t>::max());
-    return distances[to];
+    assert(false && "every universe is reachable through (z + 1) mod M");
+    return std::numeric_limits<std::size_t>::max();
 }
 
 
@@ -136,12 +151,7 @@ void Run(std::istream& input, std::ostream& output) {
     vertex_t start, finish;
     input >> start >> finish;
 
-    ListGraph graph(universe_count);
-    for (vertex_t universe = 0; universe < universe_count; ++universe) {
-        graph.AddEdge(universe, (universe + 1) % universe_count, a_weight);
-        graph.AddEdge(universe, (universe * universe + 1) % universe_count, b_weight);
-    }
-
+    TeleportGraph graph(universe_count, a_weight, b_weight);
     auto path_weight = FindShortestPath(graph, start, finish);
     output << path_weight << std::endl;
 }